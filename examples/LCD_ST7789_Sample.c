@@ -14,7 +14,7 @@
  *
  * 使用说明：
  *   1. 需先初始化LCD（spi_lcd_init）
- *   2. 在MSH下输入 lcd_test_gradient / lcd_test_char / lcd_test_graphics 运行对应测试
+ *   2. 在MSH下输入 lcd_test_gradient / lcd_test_char / lcd_test_graphics / lcd_test_vsync / lcd_test_timing / lcd_test_spitune / lcd_test_blend / lcd_test_rotate 运行对应测试
  * =====================================================================================
  */
 
@@ -23,6 +23,7 @@
 #include <rtdevice.h>
 #include <drv_common.h>
 #include <drv_spi.h> /* 添加SPI驱动头文件 */
+#include <stdlib.h>
 #include "font.h"    /* 包含字体数据头文件 */
 
 /* 颜色数组，用于图形测试 */
@@ -35,102 +36,49 @@ static uint16_t color_array[] = {
  * @return 0-成功 -1-失败
  *
  * 功能说明：
- * 1. 分块绘制渐变色背景
+ * 1. 依次绘制全屏水平、对角线、径向渐变和棋盘格图案，打印每种填充的耗时
  * 2. 可通过MSH命令调用：lcd_test_gradient
  */
 int lcd_test_gradient(int argc, char **argv)
 {
+    static u16 tile[16 * 16];
+    u16 w = lcddev.width, h = lcddev.height;
+    rt_tick_t t0;
+    int i;
+
     if (argc > 1)
     {
         rt_kprintf("Usage: lcd_test_gradient\n");
         return -1;
     }
-    static rt_device_t lcd_dev = RT_NULL;
-    lcd_dev = rt_device_find("spi_lcd");
-    if (!lcd_dev)
+    if (!rt_device_find("spi_lcd"))
     {
         rt_kprintf("LCD not initialized, run 'rt_hw_lcd_init' first\n");
         return -1;
     }
 
-    LCD_Clear(BLACK);
+    // 16x16棋盘格，8x8一格
+    for (i = 0; i < 16 * 16; i++)
+        tile[i] = (((i >> 3) ^ (i >> 7)) & 1) ? WHITE : BLACK;
 
-    /* 测试3: 绘制渐变 - 优化为分块绘制 */
-    LCD_Clear(BLACK);
-    rt_kprintf("Test3: Drawing optimized gradient...\n");
-
-    /* 强制设置扫描方向为从左到右，从上到下 */
-    rt_thread_mdelay(10); // 确保方向设置完成
-
-#define GRADIENT_BLOCK_SIZE 16 // 16x16像素块
+    t0 = rt_tick_get();
+    LCD_FillLinearGradient(0, 0, w - 1, h - 1, 0, 0, RED, w - 1, 0, BLUE);
+    rt_kprintf("Linear (horizontal): %d ms\n", (int)(rt_tick_get() - t0) * 1000 / RT_TICK_PER_SECOND);
+    rt_thread_mdelay(1000);
 
-    for (uint16_t block_y = 0; block_y < lcddev.height; block_y += GRADIENT_BLOCK_SIZE)
-    {
-        uint16_t end_y = (block_y + GRADIENT_BLOCK_SIZE > lcddev.height) ? lcddev.height : block_y + GRADIENT_BLOCK_SIZE;
+    t0 = rt_tick_get();
+    LCD_FillLinearGradient(0, 0, w - 1, h - 1, 0, 0, BLUE, w - 1, h - 1, GREEN);
+    rt_kprintf("Linear (diagonal):   %d ms\n", (int)(rt_tick_get() - t0) * 1000 / RT_TICK_PER_SECOND);
+    rt_thread_mdelay(1000);
 
-        for (uint16_t block_x = 0; block_x < lcddev.width; block_x += GRADIENT_BLOCK_SIZE)
-        {
-            uint16_t end_x = (block_x + GRADIENT_BLOCK_SIZE > lcddev.width) ? lcddev.width : block_x + GRADIENT_BLOCK_SIZE;
-
-            // 计算块四角颜色(双线性插值)
-            uint16_t x1 = block_x;
-            uint16_t y1 = block_y;
-            uint16_t x2 = (block_x + GRADIENT_BLOCK_SIZE >= lcddev.width) ? lcddev.width - 1 : block_x + GRADIENT_BLOCK_SIZE;
-            uint16_t y2 = (block_y + GRADIENT_BLOCK_SIZE >= lcddev.height) ? lcddev.height - 1 : block_y + GRADIENT_BLOCK_SIZE;
-
-            // 计算四角颜色
-            uint16_t c00_r = (x1 * 31) / (lcddev.width - 1);
-            uint16_t c00_g = (y1 * 63) / (lcddev.height - 1);
-            uint16_t c00_b = 31 - (x1 * 31) / (lcddev.width - 1);
-            uint16_t c00 = (c00_r << 11) | (c00_g << 5) | c00_b;
-
-            uint16_t c01_r = (x1 * 31) / (lcddev.width - 1);
-            uint16_t c01_g = (y2 * 63) / (lcddev.height - 1);
-            uint16_t c01_b = 31 - (x1 * 31) / (lcddev.width - 1);
-            uint16_t c01 = (c01_r << 11) | (c01_g << 5) | c01_b;
-
-            uint16_t c10_r = (x2 * 31) / (lcddev.width - 1);
-            uint16_t c10_g = (y1 * 63) / (lcddev.height - 1);
-            uint16_t c10_b = 31 - (x2 * 31) / (lcddev.width - 1);
-            uint16_t c10 = (c10_r << 11) | (c10_g << 5) | c10_b;
-
-            uint16_t c11_r = (x2 * 31) / (lcddev.width - 1);
-            uint16_t c11_g = (y2 * 63) / (lcddev.height - 1);
-            uint16_t c11_b = 31 - (x2 * 31) / (lcddev.width - 1);
-            uint16_t c11 = (c11_r << 11) | (c11_g << 5) | c11_b;
-
-            // 填充块(逐行绘制渐变)
-            for (uint16_t y = y1; y <= y2; y++)
-            {
-                for (uint16_t x = x1; x <= x2; x++)
-                {
-                    // 双线性插值计算颜色
-                    float tx = (float)(x - x1) / (x2 - x1);
-                    float ty = (float)(y - y1) / (y2 - y1);
-
-                    uint16_t r = (1 - tx) * (1 - ty) * c00_r + tx * (1 - ty) * c10_r +
-                                 (1 - tx) * ty * c01_r + tx * ty * c11_r;
-                    uint16_t g = (1 - tx) * (1 - ty) * c00_g + tx * (1 - ty) * c10_g +
-                                 (1 - tx) * ty * c01_g + tx * ty * c11_g;
-                    uint16_t b = (1 - tx) * (1 - ty) * c00_b + tx * (1 - ty) * c10_b +
-                                 (1 - tx) * ty * c01_b + tx * ty * c11_b;
-                    uint16_t color = (r << 11) | (g << 5) | b;
-
-                    LCD_DrawPoint(x, y, color);
-                }
-            }
-
-            // 每5个块打印一次进度
-            if ((block_x / GRADIENT_BLOCK_SIZE) % 5 == 0)
-            {
-                rt_kprintf("Drawing block (%d,%d) color=0x%04X\n",
-                           block_x, block_y);
-            }
-        }
+    t0 = rt_tick_get();
+    LCD_FillRadialGradient(0, 0, w - 1, h - 1, w / 2, h / 2, (w < h ? w : h) / 2, WHITE, BLUE);
+    rt_kprintf("Radial:              %d ms\n", (int)(rt_tick_get() - t0) * 1000 / RT_TICK_PER_SECOND);
+    rt_thread_mdelay(1000);
 
-        // 每行块之间添加延时
-        rt_thread_mdelay(5);
-    }
+    t0 = rt_tick_get();
+    LCD_FillPattern(0, 0, w - 1, h - 1, tile, 16, 16);
+    rt_kprintf("Pattern:             %d ms\n", (int)(rt_tick_get() - t0) * 1000 / RT_TICK_PER_SECOND);
     rt_thread_mdelay(500);
 
     return 0;
@@ -230,3 +178,252 @@ int lcd_test_graphics(int argc, char **argv)
     rt_thread_mdelay(1000);
 }
 MSH_CMD_EXPORT(lcd_test_graphics, "Test LCD graphics drawing");
+
+/**
+ * @brief LCD垂直同步动画测试
+ * @return 0-成功 -1-失败
+ *
+ * 功能说明：
+ * 1. 开启TE后每个消隐期移动一次色条
+ * 2. 统计实际帧数，验证LCD_WaitVSync节拍
+ * 3. 可通过MSH命令调用：lcd_test_vsync
+ */
+int lcd_test_vsync(int argc, char **argv)
+{
+    if (argc > 1)
+    {
+        rt_kprintf("Usage: lcd_test_vsync\n");
+        return -1;
+    }
+
+    if (LCD_TE_Enable(1) != RT_EOK)
+    {
+        rt_kprintf("TE not configured, enable PKG_ST7789_USING_TE first\n");
+        return -1;
+    }
+
+    LCD_Clear(BLACK);
+
+    uint16_t bar_h = 16;
+    uint16_t y = 0;
+    uint32_t frames = 0;
+    rt_tick_t start = rt_tick_get();
+
+    while (rt_tick_get() - start < RT_TICK_PER_SECOND * 3)
+    {
+        if (LCD_WaitVSync(100) != RT_EOK)
+        {
+            rt_kprintf("VSync timeout, check TE wiring\n");
+            break;
+        }
+
+        // 擦除旧色条，绘制新色条
+        LCD_Fill(0, y, lcddev.width - 1, y + bar_h - 1, BLACK);
+        y = (y + 4 + bar_h > lcddev.height) ? 0 : y + 4;
+        LCD_Fill(0, y, lcddev.width - 1, y + bar_h - 1, color_array[frames % 6]);
+        frames++;
+    }
+
+    rt_kprintf("VSync frames in 3s: %d\n", frames);
+    LCD_TE_Enable(0);
+
+    return 0;
+}
+MSH_CMD_EXPORT(lcd_test_vsync, "Test LCD TE synchronized animation");
+
+/**
+ * @brief LCD帧率设置测试
+ * @return 0-成功 -1-失败
+ *
+ * 功能说明：
+ * 1. 可选参数为目标刷新率(Hz)，不带参数时只查看当前设置
+ * 2. 打印面板刷新率以及全屏刷新的SPI带宽上限/TE同步帧率
+ * 3. 可通过MSH命令调用：lcd_test_timing [hz]
+ */
+int lcd_test_timing(int argc, char **argv)
+{
+    if (argc > 2)
+    {
+        rt_kprintf("Usage: lcd_test_timing [hz]\n");
+        return -1;
+    }
+
+    if (argc == 2)
+    {
+        LCD_SetRefreshRate(atoi(argv[1]));
+    }
+
+    u16 panel = LCD_GetFrameRate();
+    u16 spi_fps = LCD_GetFlushRate(lcddev.width, lcddev.height, 0);
+    u16 te_fps = LCD_GetFlushRate(lcddev.width, lcddev.height, 1);
+
+    rt_kprintf("Panel refresh : %d.%d Hz\n", panel / 10, panel % 10);
+    rt_kprintf("Full screen   : %d.%d fps (SPI bound)\n", spi_fps / 10, spi_fps % 10);
+    rt_kprintf("Full screen   : %d.%d fps (TE synced)\n", te_fps / 10, te_fps % 10);
+
+    return 0;
+}
+MSH_CMD_EXPORT(lcd_test_timing, "Show or set LCD refresh rate");
+
+/**
+ * @brief LCD SPI时钟校准测试
+ * @return 0-成功 -1-失败
+ *
+ * 功能说明：
+ * 1. 可选参数为扫描范围与步进(Hz)，默认10MHz~80MHz、步进5MHz
+ * 2. 写入测试图样并回读校验，结果通过LCD_SPI_SaveHz保存
+ * 3. 可通过MSH命令调用：lcd_test_spitune [min max step]
+ */
+int lcd_test_spitune(int argc, char **argv)
+{
+    rt_uint32_t min_hz = 10000000, max_hz = 80000000, step_hz = 5000000;
+    rt_uint32_t hz = 0;
+    rt_err_t ret;
+
+    if (argc != 1 && argc != 4)
+    {
+        rt_kprintf("Usage: lcd_test_spitune [min max step]\n");
+        return -1;
+    }
+
+    if (argc == 4)
+    {
+        min_hz = atoi(argv[1]);
+        max_hz = atoi(argv[2]);
+        step_hz = atoi(argv[3]);
+    }
+
+    ret = LCD_SPI_AutoTune(min_hz, max_hz, step_hz, &hz);
+    if (ret != RT_EOK)
+    {
+        rt_kprintf("SPI tune failed: %ld, keep %u Hz\n", ret, LCD_SPI_GetHz());
+        return -1;
+    }
+
+    rt_kprintf("SPI clock: %u Hz\n", hz);
+    LCD_Clear(WHITE);
+
+    return 0;
+}
+MSH_CMD_EXPORT(lcd_test_spitune, "Tune LCD SPI clock by read-back");
+
+/**
+ * @brief LCD回读混合测试
+ * @return 0-成功 -1-失败
+ *
+ * 功能说明：
+ * 1. 绘制彩色条纹背景
+ * 2. 叠加不同透明度的半透明色块，并回读像素打印验证
+ * 3. 可通过MSH命令调用：lcd_test_blend
+ */
+int lcd_test_blend(int argc, char **argv)
+{
+    u16 i, px = 0;
+    u16 bar = lcddev.width / 6;
+
+    if (argc > 1)
+    {
+        rt_kprintf("Usage: lcd_test_blend\n");
+        return -1;
+    }
+
+    for (i = 0; i < 6; i++)
+    {
+        LCD_Fill(i * bar, 0, (i + 1) * bar - 1, lcddev.height - 1, color_array[i]);
+    }
+
+    for (i = 0; i < 4; i++)
+    {
+        if (LCD_BlendFill(10 + i * 20, 20 + i * 40, lcddev.width - 20 - i * 40, 40, BLACK, 64 * (i + 1) - 1) != RT_EOK)
+        {
+            rt_kprintf("Blend failed, enable PKG_ST7789_USING_READ and wire SDO\n");
+            return -1;
+        }
+    }
+
+    LCD_ReadRect(bar / 2, 30, 1, 1, &px);
+    rt_kprintf("Pixel (%d,30) after blend: 0x%04X\n", bar / 2, px);
+
+    return 0;
+}
+MSH_CMD_EXPORT(lcd_test_blend, "Test LCD read-back alpha blending");
+
+/**
+ * @brief LCD图片旋转测试与性能对比
+ * @return 0-成功 -1-失败
+ *
+ * 功能说明：
+ * 1. 生成带方向标记的测试图，分别以MADCTL切换与软件转置两种方式按0/90/180/270度各显示若干次
+ * 2. 打印每种方式每幅图的平均耗时(us)，两种方式画面应完全相同
+ * 3. 最后在屏幕上排列显示8种旋转/镜像组合
+ * 4. 可通过MSH命令调用：lcd_test_rotate [次数]
+ */
+int lcd_test_rotate(int argc, char **argv)
+{
+    const u16 w = 96, h = 64;
+    u16 *img;
+    u16 i, j, loops = 20;
+    u8 rot, soft;
+    rt_tick_t t0;
+    rt_uint32_t us;
+
+    if (argc > 2)
+    {
+        rt_kprintf("Usage: lcd_test_rotate [loops]\n");
+        return -1;
+    }
+    if (argc == 2)
+        loops = atoi(argv[1]);
+    if (loops == 0)
+        loops = 1;
+
+    img = rt_malloc(w * h * sizeof(u16));
+    if (img == RT_NULL)
+    {
+        rt_kprintf("No memory for test image\n");
+        return -1;
+    }
+
+    // 渐变底色，左上角红色方块、上边缘白线标记方向
+    for (j = 0; j < h; j++)
+    {
+        for (i = 0; i < w; i++)
+        {
+            u16 c = ((i * 31 / w) << 11) | ((j * 63 / h) << 5) | 8;
+            if (i < 16 && j < 16)
+                c = RED;
+            else if (j < 2)
+                c = WHITE;
+            img[j * w + i] = c;
+        }
+    }
+
+    LCD_Clear(BLACK);
+    rt_kprintf("rotate  madctl(us)  soft(us)\n");
+    for (rot = LCD_ROTATE_0; rot <= LCD_ROTATE_270; rot++)
+    {
+        rt_uint32_t cost[2];
+
+        for (soft = 0; soft < 2; soft++)
+        {
+            t0 = rt_tick_get();
+            for (i = 0; i < loops; i++)
+                LCD_ShowImageRotate(0, 0, w, h, img, rot | (soft ? LCD_ROTATE_SOFT : 0));
+            us = (rt_tick_get() - t0) * (1000000 / RT_TICK_PER_SECOND);
+            cost[soft] = us / loops;
+        }
+        rt_kprintf("%6d  %10u  %8u\n", rot * 90, cost[0], cost[1]);
+    }
+
+    // 8种组合排成两行：上行为旋转，下行为左右镜像后旋转
+    LCD_Clear(BLACK);
+    for (i = 0; i < 8; i++)
+    {
+        LCD_ShowImageRotate((i % 4) * (lcddev.width / 4), (i / 4) * (lcddev.height / 2), w, h, img,
+                            (i % 4) | ((i / 4) ? LCD_MIRROR_H : 0));
+    }
+
+    rt_free(img);
+    return 0;
+}
+MSH_CMD_EXPORT(lcd_test_rotate, "Benchmark LCD image rotation methods");
@@ -37,6 +37,27 @@
 #define LCD_BLK_PIN PKG_ST_7789_BLK_PIN      // 背光
 #define LCD_CS_PIN PKG_ST_7789_CS_PIN        // SPI片选
 #define LCD_SPI_BUS PKG_ST_7789_SPI_BUS_NAME // SPI总线名
+#ifdef PKG_ST_7789_SPI_MAX_HZ
+#define LCD_SPI_MAX_HZ PKG_ST_7789_SPI_MAX_HZ // SPI写时钟(Hz)
+#else
+#define LCD_SPI_MAX_HZ (25 * 1000 * 1000)
+#endif
+#ifdef PKG_ST7789_USING_READ
+#define LCD_SPI_READ_HZ PKG_ST_7789_SPI_READ_HZ // SPI读时钟(Hz)，读周期须不小于150ns
+#endif
+#ifdef PKG_ST7789_USING_TE
+#define LCD_TE_PIN PKG_ST_7789_TE_PIN        // TE(撕裂效应)输出引脚
+#endif
+#ifdef PKG_ST_7789_X_OFFSET
+#define LCD_X_OFFSET PKG_ST_7789_X_OFFSET // 竖屏时可见区域在GRAM中的列偏移
+#else
+#define LCD_X_OFFSET 0
+#endif
+#ifdef PKG_ST_7789_Y_OFFSET
+#define LCD_Y_OFFSET PKG_ST_7789_Y_OFFSET // 竖屏时可见区域在GRAM中的行偏移
+#else
+#define LCD_Y_OFFSET 0
+#endif
 
 // 引脚控制宏
 #define LCD_RES_CLR rt_pin_write(LCD_RES_PIN, PIN_LOW)
@@ -62,6 +83,15 @@ typedef uint32_t u32;
 #define D2U_L2R 6 // 从下到上,从左到右
 #define D2U_R2L 7 // 从下到上,从右到左
 
+// 图片旋转/镜像(LCD_ShowImageRotate)，镜像先于旋转
+#define LCD_ROTATE_0 0x00    // 不旋转
+#define LCD_ROTATE_90 0x01   // 顺时针90度
+#define LCD_ROTATE_180 0x02  // 180度
+#define LCD_ROTATE_270 0x03  // 顺时针270度
+#define LCD_MIRROR_H 0x04    // 左右镜像
+#define LCD_MIRROR_V 0x08    // 上下镜像
+#define LCD_ROTATE_SOFT 0x10 // 软件转置(默认临时切换MADCTL)
+
 #define PORTRAIT U2D_R2L  // 竖屏方向
 #define LANDSCAPE L2R_U2D // 横屏方向
 #define Landscape 1       // 1:横屏 0:竖屏
@@ -75,6 +105,38 @@ extern u8 DFT_SCAN_DIR;   // 当前扫描方向
 #define BLUE 0x001F
 #define YELLOW 0xFFE0
 
+//==================== 像素格式定义 ==========================
+#define LCD_PIXFMT_RGB565 0x05 // 16位/像素(默认)
+#define LCD_PIXFMT_RGB444 0x03 // 12位/像素，2像素3字节
+
+//==================== 面板型号 ==============================
+#define LCD_GRAM_W 240 // 控制器GRAM列数
+#define LCD_GRAM_H 320 // 控制器GRAM行数
+
+/* 初始化序列：每项依次为 命令, 参数个数, 延时(ms), 参数...，以LCD_SEQ_END结束 */
+#define LCD_SEQ_END 0xFF
+
+/**
+ * @brief 面板型号(初始化序列与GRAM偏移)
+ *
+ * 小于240x320的面板只使用GRAM的一部分，偏移按竖屏方向(MADCTL=0x00)给出，
+ * 其它方向下的CASET/RASET偏移由驱动按MADCTL自动换算。
+ */
+typedef struct
+{
+    const u8 *init_seq; // 初始化序列
+    u16 width;          // 竖屏宽度(像素)
+    u16 height;         // 竖屏高度(像素)
+    u16 x_off;          // 可见区域在GRAM中的列偏移
+    u16 y_off;          // 可见区域在GRAM中的行偏移
+} lcd_panel_t;
+
+extern const lcd_panel_t lcd_panel_240x320; // 2.0"/2.4" TN
+extern const lcd_panel_t lcd_panel_240x280; // 1.69" IPS
+extern const lcd_panel_t lcd_panel_240x240; // 1.3"/1.54" IPS
+extern const lcd_panel_t lcd_panel_170x320; // 1.9" IPS
+extern const lcd_panel_t lcd_panel_135x240; // 1.14" IPS
+
 //==================== 结构体定义 ============================
 /**
  * @brief LCD设备参数结构体
@@ -90,15 +152,460 @@ typedef struct
 } _lcd_dev;
 extern _lcd_dev lcddev;
 
+#if defined(PKG_ST7789_USING_STATS) || defined(PKG_ST7789_USING_TRACE) || defined(PKG_ST7789_USING_OVERLAY)
+#define LCD_USING_PROFILE // 统计、跟踪与叠加层共用接口入口/出口钩子和计时源
+#endif
+
+#ifdef LCD_USING_PROFILE
+//==================== 性能统计与跟踪 ========================
+// 接口编号，与LCD_StatName对应
+enum
+{
+    LCD_STAT_CLEAR = 0,  // Clear
+    LCD_STAT_POINT,      // DrawPoint
+    LCD_STAT_POINTS,     // DrawPoints
+    LCD_STAT_FILL,       // Fill
+    LCD_STAT_FILL_RECTS, // FillRects/FillRectsColor
+    LCD_STAT_COLOR_FILL, // Color_Fill
+    LCD_STAT_CHAR,       // ShowChar
+    LCD_STAT_STRING,     // ShowString
+    LCD_STAT_SHOWNUM,    // ShowNum/ShowxNum
+    LCD_STAT_IMAGE,      // ShowImage
+    LCD_STAT_BLIT,       // BlitImage
+    LCD_STAT_ROTATE,     // ShowImageRotate
+    LCD_STAT_SPRITE,     // Sprite_Draw
+    LCD_STAT_ALPHA,      // ShowAlphaImage
+    LCD_STAT_GRADIENT,   // FillLinearGradient/FillRadialGradient
+    LCD_STAT_PATTERN,    // FillPattern
+    LCD_STAT_LINE,       // DrawLine
+    LCD_STAT_RECT,       // DrawRectangle
+    LCD_STAT_CIRCLE,     // Draw_Circle
+    LCD_STAT_FLUSH,      // DispFlush
+    LCD_STAT_FLUSH_SYNC, // DispFlushSync
+    LCD_STAT_FB_FLUSH,   // PalFB/MonoFB/RgbFB刷新
+    LCD_STAT_READ,       // ReadRect
+    LCD_STAT_BLEND,      // BlendFill/BlendImage
+    LCD_STAT_OTHER,      // 不属于上述接口的传输(初始化、方向、模式设置等)
+    LCD_STAT_MAX
+};
+
+// 跟踪记录中的SPI传输类型，接在接口编号之后
+#define LCD_TRACE_CMD (LCD_STAT_MAX + 0)  // 命令及参数
+#define LCD_TRACE_DATA (LCD_STAT_MAX + 1) // 数据
+#define LCD_TRACE_READ (LCD_STAT_MAX + 2) // 回读
+#endif
+
+#ifdef PKG_ST7789_USING_STATS
+/**
+ * @brief 单个接口的累计统计
+ *
+ * 嵌套调用(如ShowString内部的ShowChar)只计入调用次数，
+ * 字节数、传输次数、窗口设置次数与耗时都记在最外层接口上。
+ */
+typedef struct
+{
+    u32 calls;        // 调用次数
+    u32 bytes;        // SPI发送字节数(含命令与参数)
+    u32 xfers;        // SPI传输次数
+    u32 windows;      // 地址窗口设置次数
+    rt_uint64_t time; // 累计耗时(tick，使用DWT时为CPU周期)
+} lcd_stat_t;
+#endif
+
+#ifdef PKG_ST7789_USING_TRACE
+/**
+ * @brief 跟踪记录
+ *
+ * 每个最外层接口与每次SPI传输各一条，按完成顺序写入环形缓冲区，
+ * 接口记录的窗口为期间设置过的全部窗口的外接矩形。
+ */
+typedef struct
+{
+    rt_uint32_t ts;           // 开始时刻(tick，使用DWT时为CPU周期)
+    rt_uint32_t dur;          // 持续时间
+    rt_uint32_t bytes;        // 字节数(接口记录为期间传输的总字节数)
+    const char *dev;          // 实例的SPI设备名
+    char thread[RT_NAME_MAX]; // 调用线程名
+    u16 x, y, w, h;           // 窗口
+    u8 op;                    // LCD_STAT_xxx或LCD_TRACE_xxx
+} lcd_trace_rec_t;
+#endif
+
+#ifdef PKG_ST7789_USING_OVERLAY
+// 性能叠加层位置
+#define LCD_OVL_TOP_LEFT 0
+#define LCD_OVL_TOP_RIGHT 1
+#define LCD_OVL_BOTTOM_LEFT 2
+#define LCD_OVL_BOTTOM_RIGHT 3
+#endif
+
+#define LCD_BATCH_BUFFER_SIZE 20480 // 每个实例的批量传输缓冲区大小(字节)
+
+/**
+ * @brief LCD实例(每块面板一个)
+ *
+ * 硬件配置部分由用户在LCDx_Attach前填写，其余成员由驱动维护。
+ * 默认实例由spi_lcd_init按Kconfig配置创建，LCD_xxx接口均作用于默认实例。
+ */
+typedef struct lcd_st7789
+{
+    /* 硬件配置 */
+    const char *spi_bus;  // SPI总线名
+    const char *spi_name; // 挂载的SPI设备名(各实例须不同)
+    rt_base_t cs_pin;     // 片选
+    rt_base_t dc_pin;     // 数据/命令选择
+    rt_base_t res_pin;    // 复位，-1表示未连接
+    rt_base_t blk_pin;    // 背光，-1表示未连接
+    rt_base_t te_pin;     // TE输出，-1表示未连接
+    const lcd_panel_t *panel; // 面板型号，RT_NULL时按panel_w/panel_h使用默认序列
+    u16 panel_w;          // 面板宽度(竖屏)，设置panel时由其覆盖
+    u16 panel_h;          // 面板高度(竖屏)，设置panel时由其覆盖
+    rt_uint32_t max_hz;   // SPI写时钟，0使用PKG_ST_7789_SPI_MAX_HZ
+    u8 *batch;            // 批量缓冲区(字对齐，LCD_BATCH_BUFFER_SIZE字节)，RT_NULL时自动申请
+    void (*on_ready)(struct lcd_st7789 *lcd); // 异步初始化完成回调(在初始化线程中调用)，可为RT_NULL
+
+    /* 运行状态 */
+    struct rt_spi_device *spi; // SPI设备
+    _lcd_dev *dev;             // 显示参数(默认实例指向lcddev)
+    _lcd_dev dev_data;         // 非默认实例的显示参数
+    u8 scan_dir;               // 当前扫描方向
+    u8 madctl;                 // 当前MADCTL(0x36)值
+    u8 bulk_fmt;               // 批量传输像素格式
+    u8 batch_owned;            // 批量缓冲区是否由驱动申请
+    u16 fill_count;            // 批量缓冲区开头已填为fill_wire的像素数，0表示内容未知
+    u16 fill_wire;             // 上述像素的颜色(发送字节序)
+    rt_uint32_t spi_hz;        // 当前SPI写时钟(Hz)
+    u16 x_off;                 // 当前方向下的CASET地址偏移
+    u16 y_off;                 // 当前方向下的RASET地址偏移
+    volatile u8 ready;         // 面板初始化完成
+
+#ifdef PKG_ST7789_USING_ASYNC_INIT
+    struct rt_event ready_evt; // 初始化完成事件
+    rt_thread_t init_tid;      // 初始化线程
+    u8 ready_inited;
+#endif
+
+    struct
+    {
+        u16 start_row; // 局部区域起始行(面板物理行)
+        u16 end_row;   // 局部区域结束行(面板物理行)
+        u8 partial;    // 1:局部显示模式 0:正常显示模式
+        u8 idle;       // 1:空闲模式 0:全色模式
+    } mode;            // 局部显示/空闲模式，LCDx_Init后据此恢复
+
+    struct
+    {
+        u8 bpa;  // 后门廊(0x01~0x7F)
+        u8 fpa;  // 前门廊(0x01~0x7F)
+        u8 rtna; // 每行时钟数RTNA(0x00~0x1F)，0x0F约60Hz
+    } timing;    // 帧率与门廊(PORCTRL/FRCTRL2)
+
+#ifdef PKG_ST7789_USING_TE
+    struct rt_semaphore te_sem;   // TE沿信号量
+    volatile rt_tick_t te_tick;   // 最近一次TE沿的时刻
+    volatile rt_tick_t te_period; // 平滑后的帧周期(tick)，0表示尚未测得
+    u8 te_inited;
+    u8 te_enabled;
+#endif
+
+#ifdef LCD_USING_PROFILE
+    u8 prof_op;          // 当前最外层接口
+    u8 prof_depth;       // 接口嵌套深度
+    u8 prof_mute;        // 1:暂停统计/跟踪(叠加层绘制自身时)
+    rt_uint32_t prof_t0; // 最外层接口进入时刻
+#endif
+#ifdef PKG_ST7789_USING_STATS
+    lcd_stat_t stats[LCD_STAT_MAX]; // 各接口累计统计
+#endif
+#ifdef PKG_ST7789_USING_TRACE
+    u16 trace_win[4];        // 当前窗口(x, y, w, h)
+    u16 trace_box[4];        // 最外层接口内窗口的外接矩形(x1, y1, x2, y2)
+    rt_uint32_t trace_bytes; // 最外层接口内的传输字节数
+#endif
+#ifdef PKG_ST7789_USING_OVERLAY
+    struct lcd_overlay *overlay; // 性能叠加层，RT_NULL表示未开启
+    rt_uint32_t ovl_bytes;       // 叠加层本统计周期内的SPI字节数
+#endif
+} lcd_st7789_t;
+
+/**
+ * @brief 调色板(索引色)帧缓冲
+ */
+typedef struct
+{
+    u16 width;        // 画布宽度
+    u16 height;       // 画布高度
+    u8 bpp;           // 每像素位数(8/4)
+    u8 owned;         // 缓冲区是否由驱动申请
+    u16 stride;       // 每行字节数
+    u8 *buf;          // 索引数据
+    u16 palette[256]; // 调色板(按发送字节序存放)
+} lcd_pal_fb_t;
+
+/**
+ * @brief 单色(1bpp)帧缓冲
+ */
+typedef struct
+{
+    u16 width;      // 画布宽度
+    u16 height;     // 画布高度
+    u16 stride;     // 每行字节数
+    u8 owned;       // 缓冲区是否由驱动申请
+    u8 *buf;        // 位图数据(最高位为最左侧像素)
+    u16 lut[16][4]; // 半字节展开表(前景/背景色,按发送字节序存放)
+} lcd_mono_fb_t;
+
+/**
+ * @brief RGB565帧缓冲
+ */
+typedef struct
+{
+    u16 width;  // 画布宽度
+    u16 height; // 画布高度
+    u8 owned;   // 缓冲区是否由驱动申请
+    u16 *buf;   // 像素数据(行优先,按发送字节序存放)
+} lcd_rgb_fb_t;
+
+/**
+ * @brief 矩形区域(批量填充)
+ */
+typedef struct
+{
+    u16 x; // 左上角X坐标
+    u16 y; // 左上角Y坐标
+    u16 w; // 宽度
+    u16 h; // 高度
+} lcd_rect_t;
+
+/**
+ * @brief 精灵中的不透明矩形
+ */
+typedef struct
+{
+    u16 x; // 在精灵内的X坐标
+    u16 y; // 在精灵内的Y坐标
+    u16 w; // 宽度
+    u16 h; // 高度
+} lcd_sprite_rect_t;
+
+/**
+ * @brief 透明色精灵(由LCD_Sprite_Init预先生成)
+ */
+typedef struct
+{
+    u16 width;                // 精灵宽度
+    u16 height;               // 精灵高度
+    u16 count;                // 不透明矩形个数
+    lcd_sprite_rect_t *rects; // 矩形表，其后依次存放各矩形的像素(按发送字节序)
+} lcd_sprite_t;
+
+// 带透明度图片格式
+#define LCD_ALPHA_ARGB8888 0 // 每像素u32，A为最高字节
+#define LCD_ALPHA_RGB565A8 1 // width*height个RGB565之后紧跟width*height字节透明度
+#define LCD_ALPHA_A8 2       // 每像素1字节透明度，颜色统一为color
+
+/**
+ * @brief 带透明度的图片
+ */
+typedef struct
+{
+    u16 width;        // 宽度
+    u16 height;       // 高度
+    u8 format;        // 格式(LCD_ALPHA_xxx)
+    u16 color;        // A8格式的前景色(RGB565)
+    const void *data; // 像素数据
+} lcd_alpha_img_t;
+
+#define LCD_NUM_MAX_LEN 10 // 数字显示框最大位数(u32最多10位)
+
+/**
+ * @brief 数字显示框(只重绘变化的位)
+ */
+typedef struct
+{
+    u16 x;                      // 左上角X坐标
+    u16 y;                      // 左上角Y坐标
+    u8 len;                     // 位数
+    u8 size;                    // 字体大小(12/16)
+    u8 zero_pad;                // 1:高位补0 0:高位显示空格
+    u16 color;                  // 数字颜色
+    u16 bg_color;               // 背景颜色
+    u32 value;                  // 上次显示的数值
+    char shown[LCD_NUM_MAX_LEN]; // 屏幕上各位当前的字符，0表示未绘制
+} lcd_num_field_t;
+
+// 文本框对齐方式
+#define LCD_ALIGN_LEFT 0   // 左对齐
+#define LCD_ALIGN_CENTER 1 // 居中
+#define LCD_ALIGN_RIGHT 2  // 右对齐
+
+#define LCD_TEXT_MAX_LINES 16   // 文本框最多显示的行数
+#define LCD_PRINTF_BUF_SIZE 128 // LCD_Printf格式化缓冲区大小(字节，位于栈上)
+
+/**
+ * @brief 文本框(LCD_Printf排版区域)
+ */
+typedef struct
+{
+    u16 width;    // 区域宽度
+    u16 height;   // 区域高度
+    u8 align;     // 对齐方式(LCD_ALIGN_xxx)
+    u16 color;    // 文字颜色
+    u16 bg_color; // 背景颜色
+
+    /* 上次绘制的文字(由LCD_Printf维护) */
+    u16 x;                           // 左上角X坐标
+    u16 y;                           // 左上角Y坐标
+    u8 size;                         // 字体大小
+    u8 lines;                        // 行数，0表示没有需要擦除的文字
+    u16 span[LCD_TEXT_MAX_LINES][2]; // 各行文字的左右边界(相对x，右边界不含)
+} lcd_text_box_t;
+
+// 单色位块传送光栅操作
+#define LCD_ROP_COPY 0    // 覆盖
+#define LCD_ROP_OR 1      // 只画1
+#define LCD_ROP_AND_NOT 2 // 擦除1对应的位
+#define LCD_ROP_XOR 3     // 反色
+
+//==================== 多实例API ============================
+// 与同名LCD_xxx接口功能相同，首个参数指定操作的LCD实例
+lcd_st7789_t *LCD_GetDefault(void);                             // 获取默认实例(spi_lcd_init挂载)
+rt_err_t LCDx_Attach(lcd_st7789_t *lcd);                        // 挂载SPI设备并初始化面板
+rt_err_t LCDx_AttachAsync(lcd_st7789_t *lcd);                   // 挂载SPI设备，后台线程初始化面板
+void LCDx_Detach(lcd_st7789_t *lcd);                            // 卸载面板，释放驱动申请的资源
+rt_err_t LCDx_WaitReady(lcd_st7789_t *lcd, rt_int32_t timeout); // 等待面板初始化完成
+void LCDx_Init(lcd_st7789_t *lcd);                              // 重新初始化面板
+void LCDx_Display_Dir(lcd_st7789_t *lcd, u8 dir);               // 设置显示方向
+void LCDx_Scan_Dir(lcd_st7789_t *lcd, u8 dir);                  // 设置扫描方向
+void LCDx_SetPortrait(lcd_st7789_t *lcd);                       // 设置为竖屏
+void LCDx_SetLandscape(lcd_st7789_t *lcd);                      // 设置为横屏
+
+void LCDx_SetPartialArea(lcd_st7789_t *lcd, u16 start_row, u16 end_row);     // 设置局部显示区域
+void LCDx_PartialMode(lcd_st7789_t *lcd, u8 enable);                         // 局部显示模式开关
+void LCDx_IdleMode(lcd_st7789_t *lcd, u8 enable);                            // 空闲模式开关
+void LCDx_SetFrameRate(lcd_st7789_t *lcd, u8 rtna);                          // 设置帧率参数RTNA
+void LCDx_SetRefreshRate(lcd_st7789_t *lcd, u16 hz);                         // 按目标刷新率设置帧率
+void LCDx_SetPorch(lcd_st7789_t *lcd, u8 back_porch, u8 front_porch);        // 设置门廊
+u16 LCDx_GetFrameRate(lcd_st7789_t *lcd);                                    // 当前面板刷新率(0.1Hz)
+u16 LCDx_GetFlushRate(lcd_st7789_t *lcd, u16 width, u16 height, u8 te_sync); // 区域刷新可达帧率(0.1fps)
+rt_err_t LCDx_TE_Enable(lcd_st7789_t *lcd, u8 enable);                       // TE输出与引脚中断开关
+rt_err_t LCDx_WaitVSync(lcd_st7789_t *lcd, rt_int32_t timeout);              // 等待下一个TE沿
+rt_uint32_t LCDx_SPI_GetHz(lcd_st7789_t *lcd);                               // 当前SPI写时钟
+rt_err_t LCDx_SPI_AutoTune(lcd_st7789_t *lcd, rt_uint32_t min_hz, rt_uint32_t max_hz,
+                           rt_uint32_t step_hz, rt_uint32_t *result_hz);     // 回读校验校准SPI时钟
+
+void LCDx_Clear(lcd_st7789_t *lcd, u16 Color);                                                              // 清屏
+void LCDx_SetCursor(lcd_st7789_t *lcd, u16 Xpos, u16 Ypos);                                                 // 设置光标位置
+void LCDx_DrawPoint(lcd_st7789_t *lcd, u16 x, u16 y, u16 color);                                            // 画点
+void LCDx_DrawPoints(lcd_st7789_t *lcd, u16 *points_x, u16 *points_y, u16 point_count, u16 color);          // 批量绘制点
+void LCDx_DrawLine(lcd_st7789_t *lcd, u16 x1, u16 y1, u16 x2, u16 y2, u16 color);                           // 画线
+void LCDx_DrawRectangle(lcd_st7789_t *lcd, u16 x1, u16 y1, u16 x2, u16 y2, u16 color);                      // 画矩形
+void LCDx_Draw_Circle(lcd_st7789_t *lcd, u16 x0, u16 y0, u8 r, u16 color);                                  // 画圆
+void LCDx_Fill(lcd_st7789_t *lcd, u16 sx, u16 sy, u16 ex, u16 ey, u16 color);                               // 单色填充
+void LCDx_FillRects(lcd_st7789_t *lcd, const lcd_rect_t *rects, u16 n, u16 color);                          // 批量填充同色矩形
+void LCDx_FillRectsColor(lcd_st7789_t *lcd, const lcd_rect_t *rects, const u16 *colors, u16 n);             // 批量填充各自颜色的矩形
+void LCDx_Color_Fill(lcd_st7789_t *lcd, u16 sx, u16 sy, u16 ex, u16 ey, u16 *color);                        // 颜色块填充
+void LCDx_ShowImage(lcd_st7789_t *lcd, u16 x, u16 y, u16 width, u16 height, const u16 *p);                  // 显示图片
+void LCDx_BlitImage(lcd_st7789_t *lcd, u16 x, u16 y, const u16 *src, u16 stride,
+                    u16 sx, u16 sy, u16 width, u16 height);                                                 // 显示图集子区域
+void LCDx_ShowImageRotate(lcd_st7789_t *lcd, u16 x, u16 y, u16 width, u16 height, const u16 *p, u8 mode);   // 旋转/镜像显示图片
+void LCDx_DispFlush(lcd_st7789_t *lcd, u16 x1, u16 y1, u16 x2, u16 y2, const u16 *pData);                   // 区域刷屏
+void LCDx_DispFlushSync(lcd_st7789_t *lcd, u16 x1, u16 y1, u16 x2, u16 y2, const u16 *pData);               // TE同步区域刷屏
+void LCDx_DispFlushWire(lcd_st7789_t *lcd, u16 x1, u16 y1, u16 x2, u16 y2, const void *pData);              // 区域刷屏(发送字节序数据)
+void LCDx_SetBulkFormat(lcd_st7789_t *lcd, u8 fmt);                                                         // 批量传输像素格式
+rt_err_t LCDx_ReadRect(lcd_st7789_t *lcd, u16 x, u16 y, u16 width, u16 height, u16 *buf);                   // 回读区域像素
+rt_err_t LCDx_BlendFill(lcd_st7789_t *lcd, u16 x, u16 y, u16 width, u16 height, u16 color, u8 alpha);       // 半透明纯色叠加
+rt_err_t LCDx_BlendImage(lcd_st7789_t *lcd, u16 x, u16 y, u16 width, u16 height, const u16 *img, u8 alpha); // 半透明图片叠加
+
+void LCDx_PalFB_Flush(lcd_st7789_t *lcd, const lcd_pal_fb_t *fb, u16 x, u16 y);                                       // 调色板帧缓冲整体刷新
+void LCDx_PalFB_FlushArea(lcd_st7789_t *lcd, const lcd_pal_fb_t *fb, u16 x, u16 y, u16 sx, u16 sy, u16 ex, u16 ey);   // 调色板帧缓冲区域刷新
+void LCDx_MonoFB_Flush(lcd_st7789_t *lcd, const lcd_mono_fb_t *fb, u16 x, u16 y);                                     // 单色帧缓冲整体刷新
+void LCDx_MonoFB_FlushArea(lcd_st7789_t *lcd, const lcd_mono_fb_t *fb, u16 x, u16 y, u16 sx, u16 sy, u16 ex, u16 ey); // 单色帧缓冲区域刷新
+void LCDx_RgbFB_Flush(lcd_st7789_t *lcd, const lcd_rgb_fb_t *fb, u16 x, u16 y);                                       // RGB565帧缓冲整体刷新
+void LCDx_RgbFB_FlushArea(lcd_st7789_t *lcd, const lcd_rgb_fb_t *fb, u16 x, u16 y, u16 sx, u16 sy, u16 ex, u16 ey);   // RGB565帧缓冲区域刷新
+void LCDx_Sprite_Draw(lcd_st7789_t *lcd, const lcd_sprite_t *spr, u16 x, u16 y);                                      // 绘制精灵
+void LCDx_ShowAlphaImage(lcd_st7789_t *lcd, u16 x, u16 y, const lcd_alpha_img_t *img, u16 bg_color);                  // 纯色背景上显示带透明度图片
+void LCDx_FillLinearGradient(lcd_st7789_t *lcd, u16 sx, u16 sy, u16 ex, u16 ey,
+                             u16 x0, u16 y0, u16 c0, u16 x1, u16 y1, u16 c1);                                         // 线性渐变填充
+void LCDx_FillRadialGradient(lcd_st7789_t *lcd, u16 sx, u16 sy, u16 ex, u16 ey,
+                             u16 cx, u16 cy, u16 r, u16 c0, u16 c1);                                                  // 径向渐变填充
+void LCDx_FillPattern(lcd_st7789_t *lcd, u16 sx, u16 sy, u16 ex, u16 ey, const u16 *tile, u16 tw, u16 th);            // 图案平铺填充
+
+void LCDx_ShowChar(lcd_st7789_t *lcd, u16 x, u16 y, char chr, u8 size, u8 mode, u16 color, u16 bg_color);              // 显示字符
+void LCDx_ShowString(lcd_st7789_t *lcd, u16 x, u16 y, u16 width, u16 height, u8 size, u8 *p, u16 color, u16 bg_color); // 显示字符串
+void LCDx_ShowNum(lcd_st7789_t *lcd, u16 x, u16 y, u32 num, u8 len, u8 size, u16 color, u16 bg_color);                 // 显示数字
+void LCDx_ShowxNum(lcd_st7789_t *lcd, u16 x, u16 y, u32 num, u8 len, u8 size, u8 mode, u16 color, u16 bg_color);       // 显示数字(可补零)
+void LCDx_NumField_Show(lcd_st7789_t *lcd, lcd_num_field_t *f, u32 value);                                             // 更新数字显示框
+int LCDx_Printf(lcd_st7789_t *lcd, u16 x, u16 y, lcd_text_box_t *box, u8 size, const char *fmt, ...);                  // 格式化排版显示
+
+#ifdef PKG_ST7789_USING_GRAPHIC
+//==================== 图形设备API ===========================
+rt_err_t LCDx_GraphicRegister(lcd_st7789_t *lcd, const char *name); // 注册为RT-Thread图形设备(默认实例自动注册为"lcd")
+#endif
+
+#ifdef PKG_ST7789_USING_LVGL
+//==================== LVGL显示适配API =======================
+rt_err_t LCDx_LvglRegister(lcd_st7789_t *lcd); // 注册LVGL显示(双缓冲,异步刷新)
+#endif
+
+#ifdef LCD_USING_PROFILE
+//==================== 性能统计与跟踪API =====================
+const char *LCD_StatName(u8 id);            // 接口编号名称
+rt_uint32_t LCD_ProfToUs(rt_uint64_t time); // 计时值换算为微秒
+#endif
+#ifdef PKG_ST7789_USING_STATS
+void LCDx_StatsGet(lcd_st7789_t *lcd, lcd_stat_t *out); // 复制统计快照(out为LCD_STAT_MAX项)
+void LCDx_StatsReset(lcd_st7789_t *lcd);                // 清零统计
+void LCDx_StatsDump(lcd_st7789_t *lcd);                 // 打印统计表
+#endif
+#ifdef PKG_ST7789_USING_TRACE
+u8 LCD_TraceEnable(u8 enable);                                                        // 开始/暂停记录(默认开始)，返回原状态
+void LCD_TraceClear(void);                                                            // 清空记录
+rt_uint32_t LCD_TraceRead(rt_uint32_t start, lcd_trace_rec_t *out, rt_uint32_t max); // 从旧到新读取记录
+rt_uint32_t LCD_TraceDropped(void);                                                   // 被覆盖的记录条数
+void LCD_TraceDump(void);                                                             // 打印记录(供主机转换)
+#endif
+#ifdef PKG_ST7789_USING_OVERLAY
+rt_err_t LCDx_OverlayStart(lcd_st7789_t *lcd, u8 corner, u16 color, u16 bg_color); // 开启帧率/总线占用率叠加层
+void LCDx_OverlayStop(lcd_st7789_t *lcd);                                          // 关闭叠加层(不擦除)
+void LCDx_OverlayFrame(lcd_st7789_t *lcd);                                         // 标记一帧结束并按周期刷新显示
+void LCDx_OverlayDamage(lcd_st7789_t *lcd, u16 x1, u16 y1, u16 x2, u16 y2);        // 区域被覆盖时通知重绘
+#endif
+
 //==================== 方向切换API ===========================
 void LCD_SetPortrait(void);  // 设置为竖屏
 void LCD_SetLandscape(void); // 设置为横屏
 
 //==================== LCD初始化与配置API ====================
-int spi_lcd_init(void);       // LCD驱动初始化
-void LCD_Init(void);          // LCD初始化
-void LCD_Display_Dir(u8 dir); // 设置显示方向
-void LCD_Scan_Dir(u8 dir);    // 设置扫描方向
+int spi_lcd_init(void);                     // LCD驱动初始化
+void LCD_Init(void);                        // LCD初始化
+rt_err_t LCD_WaitReady(rt_int32_t timeout); // 等待默认面板初始化完成(ms)
+void LCD_OnReady(lcd_st7789_t *lcd);        // 默认面板异步初始化完成回调(弱函数,可重写)
+void LCD_Display_Dir(u8 dir);               // 设置显示方向
+void LCD_Scan_Dir(u8 dir);                  // 设置扫描方向
+
+//==================== 低功耗显示模式API =====================
+void LCD_SetPartialArea(u16 start_row, u16 end_row); // 设置局部显示区域(PTLAR)
+void LCD_PartialMode(u8 enable);                     // 局部显示模式开关(PTLON/NORON)
+void LCD_IdleMode(u8 enable);                        // 空闲(8色)模式开关(IDMON/IDMOFF)
+
+//==================== SPI时钟校准API =======================
+rt_err_t LCD_SPI_AutoTune(rt_uint32_t min_hz, rt_uint32_t max_hz, rt_uint32_t step_hz, rt_uint32_t *result_hz); // 回读校验校准SPI时钟
+rt_uint32_t LCD_SPI_GetHz(void);                                                                            // 当前SPI写时钟
+rt_uint32_t LCD_SPI_LoadHz(void);                                                                           // 读取保存的时钟(弱函数,可重写)
+void LCD_SPI_SaveHz(rt_uint32_t hz);                                                                        // 保存校准结果(弱函数,可重写)
+
+//==================== 帧率与门廊设置API ====================
+void LCD_SetFrameRate(u8 rtna);                          // 设置帧率参数RTNA(FRCTRL2)
+void LCD_SetRefreshRate(u16 hz);                         // 按目标刷新率(Hz)设置帧率
+void LCD_SetPorch(u8 back_porch, u8 front_porch);        // 设置门廊(PORCTRL)
+u16 LCD_GetFrameRate(void);                              // 当前面板刷新率(0.1Hz)
+u16 LCD_GetFlushRate(u16 width, u16 height, u8 te_sync); // 区域刷新可达帧率(0.1fps)
+
+//==================== 撕裂效应(TE)同步API ==================
+rt_err_t LCD_TE_Enable(u8 enable);                                                                 // TE输出与引脚中断开关(TEON/TEOFF)
+rt_err_t LCD_WaitVSync(rt_int32_t timeout);                                                        // 等待下一个TE沿(ms)，用于动画循环
+void LCD_DispFlushSync(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, const uint16_t *pData); // TE同步区域刷屏
 
 //==================== 基本绘图API ===========================
 void LCD_Clear(u16 Color);
@@ -110,16 +617,77 @@ void LCD_DrawLine(u16 x1, u16 y1, u16 x2, u16 y2, u16 color);
 void LCD_DrawRectangle(u16 x1, u16 y1, u16 x2, u16 y2, u16 color);
 void Draw_Circle(u16 x0, u16 y0, u8 r, u16 color);
 void LCD_Fill(u16 sx, u16 sy, u16 ex, u16 ey, u16 color);
+void LCD_FillRects(const lcd_rect_t *rects, u16 n, u16 color);                                 // 批量填充同色矩形
+void LCD_FillRectsColor(const lcd_rect_t *rects, const u16 *colors, u16 n);                    // 批量填充各自颜色的矩形
 void LCD_ShowImage(u16 x, u16 y, u16 width, u16 height, const u16 *p);
+void LCD_BlitImage(u16 x, u16 y, const u16 *src, u16 stride, u16 sx, u16 sy, u16 width, u16 height); // 显示图集(跨距)子区域
+void LCD_ShowImageRotate(u16 x, u16 y, u16 width, u16 height, const u16 *p, u8 mode);           // 旋转/镜像显示图片
 void LCD_Color_Fill(u16 sx, u16 sy, u16 ex, u16 ey, u16 *color);
 void LCD_DrawPoints(u16 *points_x, u16 *points_y, u16 point_count, u16 color);                 // 批量绘制点
 void LCD_DispFlush(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, const uint16_t *pData); // 区域刷屏（适配LVGL等GUI）
+void LCD_DispFlushWire(u16 x1, u16 y1, u16 x2, u16 y2, const void *pData);                     // 区域刷屏（数据已为高字节在前）
+void LCD_SetBulkFormat(u8 fmt);                                                                 // 批量传输像素格式(RGB565/RGB444)
+
+//==================== GRAM回读与混合API =====================
+rt_err_t LCD_ReadRect(u16 x, u16 y, u16 width, u16 height, u16 *buf);                   // 回读区域像素(RGB565)
+rt_err_t LCD_BlendFill(u16 x, u16 y, u16 width, u16 height, u16 color, u8 alpha);       // 半透明纯色叠加
+rt_err_t LCD_BlendImage(u16 x, u16 y, u16 width, u16 height, const u16 *img, u8 alpha); // 半透明图片叠加
+
+//==================== 调色板帧缓冲API =======================
+rt_err_t LCD_PalFB_Init(lcd_pal_fb_t *fb, u8 bpp, u16 width, u16 height, u8 *buf);              // 初始化(buf为RT_NULL时自动申请)
+void LCD_PalFB_Deinit(lcd_pal_fb_t *fb);                                                        // 释放
+void LCD_PalFB_SetPalette(lcd_pal_fb_t *fb, u16 start, u16 count, const u16 *colors);           // 设置调色板
+void LCD_PalFB_DrawPoint(lcd_pal_fb_t *fb, u16 x, u16 y, u8 index);                             // 画点
+void LCD_PalFB_Fill(lcd_pal_fb_t *fb, u16 sx, u16 sy, u16 ex, u16 ey, u8 index);                // 填充矩形
+void LCD_PalFB_Clear(lcd_pal_fb_t *fb, u8 index);                                               // 清空
+void LCD_PalFB_Flush(const lcd_pal_fb_t *fb, u16 x, u16 y);                                     // 整体刷新到屏幕
+void LCD_PalFB_FlushArea(const lcd_pal_fb_t *fb, u16 x, u16 y, u16 sx, u16 sy, u16 ex, u16 ey); // 区域刷新到屏幕
+
+//==================== 单色帧缓冲API =========================
+rt_err_t LCD_MonoFB_Init(lcd_mono_fb_t *fb, u16 width, u16 height, u8 *buf);                      // 初始化(buf为RT_NULL时自动申请)
+void LCD_MonoFB_Deinit(lcd_mono_fb_t *fb);                                                        // 释放
+void LCD_MonoFB_SetColors(lcd_mono_fb_t *fb, u16 fg, u16 bg);                                     // 设置前景/背景色
+void LCD_MonoFB_Clear(lcd_mono_fb_t *fb, u8 set);                                                 // 清空
+void LCD_MonoFB_DrawPoint(lcd_mono_fb_t *fb, u16 x, u16 y, u8 set);                               // 画点
+void LCD_MonoFB_Fill(lcd_mono_fb_t *fb, u16 sx, u16 sy, u16 ex, u16 ey, u8 set);                  // 填充矩形
+void LCD_MonoFB_Blit(lcd_mono_fb_t *fb, u16 x, u16 y, const u8 *src, u16 w, u16 h, u8 rop);       // 位块传送1bpp位图
+void LCD_MonoFB_ShowString(lcd_mono_fb_t *fb, u16 x, u16 y, u8 size, const char *p, u8 set);      // 显示字符串
+void LCD_MonoFB_Flush(const lcd_mono_fb_t *fb, u16 x, u16 y);                                     // 整体刷新到屏幕
+void LCD_MonoFB_FlushArea(const lcd_mono_fb_t *fb, u16 x, u16 y, u16 sx, u16 sy, u16 ex, u16 ey); // 区域刷新到屏幕
+
+//==================== RGB565帧缓冲与精灵API =================
+rt_err_t LCD_RgbFB_Init(lcd_rgb_fb_t *fb, u16 width, u16 height, u16 *buf);                     // 初始化(buf为RT_NULL时自动申请)
+void LCD_RgbFB_Deinit(lcd_rgb_fb_t *fb);                                                        // 释放
+void LCD_RgbFB_DrawPoint(lcd_rgb_fb_t *fb, u16 x, u16 y, u16 color);                            // 画点
+void LCD_RgbFB_Fill(lcd_rgb_fb_t *fb, u16 sx, u16 sy, u16 ex, u16 ey, u16 color);               // 填充矩形
+void LCD_RgbFB_Clear(lcd_rgb_fb_t *fb, u16 color);                                              // 清空
+void LCD_RgbFB_DrawSprite(lcd_rgb_fb_t *fb, const lcd_sprite_t *spr, u16 x, u16 y);             // 合成精灵
+void LCD_RgbFB_Flush(const lcd_rgb_fb_t *fb, u16 x, u16 y);                                     // 整体刷新到屏幕
+void LCD_RgbFB_FlushArea(const lcd_rgb_fb_t *fb, u16 x, u16 y, u16 sx, u16 sy, u16 ex, u16 ey); // 区域刷新到屏幕
+rt_err_t LCD_Sprite_Init(lcd_sprite_t *spr, const u16 *img, u16 width, u16 height, u16 key);    // 由透明色图片生成精灵
+void LCD_Sprite_Deinit(lcd_sprite_t *spr);                                                      // 释放精灵
+void LCD_Sprite_Draw(const lcd_sprite_t *spr, u16 x, u16 y);                                    // 绘制精灵(只发送不透明部分)
+
+//==================== 透明度混合API =========================
+void LCD_ShowAlphaImage(u16 x, u16 y, const lcd_alpha_img_t *img, u16 bg_color);                // 纯色背景上显示带透明度图片
+void LCD_RgbFB_DrawAlphaImage(lcd_rgb_fb_t *fb, u16 x, u16 y, const lcd_alpha_img_t *img);      // 混合到RGB565帧缓冲
+
+//==================== 渐变与图案填充API =====================
+void LCD_FillLinearGradient(u16 sx, u16 sy, u16 ex, u16 ey, u16 x0, u16 y0, u16 c0, u16 x1, u16 y1, u16 c1); // 线性渐变填充
+void LCD_FillRadialGradient(u16 sx, u16 sy, u16 ex, u16 ey, u16 cx, u16 cy, u16 r, u16 c0, u16 c1);          // 径向渐变填充
+void LCD_FillPattern(u16 sx, u16 sy, u16 ex, u16 ey, const u16 *tile, u16 tw, u16 th);                        // 图案平铺填充
 
 //==================== 文本显示API ===========================
 void LCD_ShowChar(u16 x, u16 y, char chr, u8 size, u8 mode, u16 color, u16 bg_color);
 void LCD_ShowString(u16 x, u16 y, u16 width, u16 height, u8 size, u8 *p, u16 color, u16 bg_color);
 void LCD_ShowNum(u16 x, u16 y, u32 num, u8 len, u8 size, u16 color, uint16_t bg_color);
 void LCD_ShowxNum(u16 x, u16 y, u32 num, u8 len, u8 size, u8 mode, u16 color, uint16_t bg_color);
+void LCD_NumField_Init(lcd_num_field_t *f, u16 x, u16 y, u8 len, u8 size, u8 zero_pad, u16 color, u16 bg_color); // 初始化数字显示框
+void LCD_NumField_Invalidate(lcd_num_field_t *f);                                                            // 下次更新时整体重绘
+void LCD_NumField_Show(lcd_num_field_t *f, u32 value);                                                       // 更新数字显示框(只重绘变化的位)
+void LCD_TextBox_Init(lcd_text_box_t *box, u16 width, u16 height, u8 align, u16 color, u16 bg_color);        // 初始化文本框
+void LCD_TextBox_Invalidate(lcd_text_box_t *box);                                                            // 忘记上次绘制的文字
+int LCD_Printf(u16 x, u16 y, lcd_text_box_t *box, u8 size, const char *fmt, ...);                            // 格式化、折行、对齐显示
 
 //==================== 辅助功能API ===========================
 u32 LCD_Pow(u8 m, u8 n);
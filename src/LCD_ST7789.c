@@ -31,18 +31,476 @@
 #include <rtdbg.h>
 
 #define LCD_DMA_BUFFER_SIZE 1024
-#define LCD_BATCH_BUFFER_SIZE 20480 // 批量传输缓冲区大小(字节)
-static uint8_t batch_buffer[LCD_BATCH_BUFFER_SIZE];
+static uint32_t batch_words[LCD_BATCH_BUFFER_SIZE / 4]; // 默认实例的批量缓冲区，按字对齐便于16/32位整字写入
+
+/* 把RGB565转换为SPI发送字节序(高字节在前)后按16位整字存放 */
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#define LCD_TO_WIRE16(c) ((u16)(c))
+#else
+#define LCD_TO_WIRE16(c) ((u16)(((c) >> 8) | ((c) << 8)))
+#endif
 
 u8 DFT_SCAN_DIR;
 _lcd_dev lcddev;
-static struct rt_spi_device *lcd_dev;
+
+/* 帧率计算参数 */
+#define LCD_GATE_LINES 320     // ST7789驱动的门线数(与面板实际行数无关)
+#define LCD_OSC_HZ 10000000UL // 内部振荡器频率(10MHz)
+
+/* 批量传输像素格式(LCDx_SetBulkFormat)，单点/字符等小数据量写入始终为RGB565 */
+#define LCD_RGB444_MIN_PIXELS 64                                   // 少于此像素数时切换COLMOD得不偿失
+#define LCD_RGB444_BATCH_PIXELS ((LCD_BATCH_BUFFER_SIZE / 3) * 2) // 每批次像素数(偶数,3字节/2像素)
+
+#ifdef PKG_ST7789_USING_TE
+#define LCD_TE_PERIOD_MAX (RT_TICK_PER_SECOND / 10) // 超过100ms的间隔视为TE中断曾被关闭
+#endif
+
+/* 初始化序列(lcd.c原序列)：命令, 参数个数, 延时(ms), 参数... */
+#define LCD_SEQ_ST7789V                                                    \
+    0x11, 0, 120,                  /* SLPOUT */                            \
+    0x3a, 1, 0, LCD_PIXFMT_RGB565, /* COLMOD */                            \
+    0xb7, 1, 0, 0x35,              /* GCTRL */                             \
+    0xbb, 1, 0, 0x28,              /* VCOMS */                             \
+    0xc0, 1, 0, 0x2c,              /* LCMCTRL */                           \
+    0xc2, 1, 0, 0x01,              /* VDVVRHEN */                          \
+    0xc3, 1, 0, 0x10,              /* VRHS */                              \
+    0xc4, 1, 0, 0x20,              /* VDVS */                              \
+    0xd0, 2, 0, 0xa4, 0xa1,        /* PWCTRL1 */                           \
+    0xe0, 14, 0,                   /* PVGAMCTRL */                         \
+    0xd0, 0x00, 0x02, 0x07, 0x0a, 0x28, 0x32, 0x44,                        \
+    0x42, 0x06, 0x0e, 0x12, 0x14, 0x17,                                    \
+    0xe1, 14, 0,                   /* NVGAMCTRL */                         \
+    0xd0, 0x00, 0x02, 0x07, 0x0a, 0x28, 0x31, 0x54,                        \
+    0x47, 0x0e, 0x1c, 0x17, 0x1b, 0x1e
+
+/* TN面板 */
+static const u8 lcd_seq_tn[] = {
+    LCD_SEQ_ST7789V,
+    LCD_SEQ_END,
+};
+
+/* IPS面板需要反显(INVON) */
+static const u8 lcd_seq_ips[] = {
+    LCD_SEQ_ST7789V,
+    0x21, 0, 0, /* INVON */
+    LCD_SEQ_END,
+};
+
+const lcd_panel_t lcd_panel_240x320 = {lcd_seq_tn, 240, 320, 0, 0};
+const lcd_panel_t lcd_panel_240x280 = {lcd_seq_ips, 240, 280, 0, 20};
+const lcd_panel_t lcd_panel_240x240 = {lcd_seq_ips, 240, 240, 0, 0};
+const lcd_panel_t lcd_panel_170x320 = {lcd_seq_ips, 170, 320, 35, 0};
+const lcd_panel_t lcd_panel_135x240 = {lcd_seq_ips, 135, 240, 52, 40};
+
+/* 默认实例的面板，由Kconfig配置 */
+#ifdef PKG_ST7789_USING_INVERSION
+static const lcd_panel_t lcd_panel_kconfig = {lcd_seq_ips, LCD_W, LCD_H, LCD_X_OFFSET, LCD_Y_OFFSET};
+#else
+static const lcd_panel_t lcd_panel_kconfig = {lcd_seq_tn, LCD_W, LCD_H, LCD_X_OFFSET, LCD_Y_OFFSET};
+#endif
+
+/* 默认实例，由spi_lcd_init按Kconfig配置挂载 */
+static lcd_st7789_t lcd_default = {
+    .spi_bus = LCD_SPI_BUS,
+    .spi_name = "spi_lcd",
+    .cs_pin = LCD_CS_PIN,
+    .dc_pin = LCD_DC_PIN,
+    .res_pin = LCD_RES_PIN,
+    .blk_pin = LCD_BLK_PIN,
+#ifdef PKG_ST7789_USING_TE
+    .te_pin = LCD_TE_PIN,
+#else
+    .te_pin = -1,
+#endif
+    .panel = &lcd_panel_kconfig,
+    .panel_w = LCD_W,
+    .panel_h = LCD_H,
+    .max_hz = 0,
+    .batch = (u8 *)batch_words,
+    .on_ready = LCD_OnReady,
+    .dev = &lcddev,
+};
+
+/* 实例引脚控制 */
+#define LCD_DC_LOW(lcd) rt_pin_write((lcd)->dc_pin, PIN_LOW)
+#define LCD_DC_HIGH(lcd) rt_pin_write((lcd)->dc_pin, PIN_HIGH)
+#define LCD_RES_LOW(lcd) rt_pin_write((lcd)->res_pin, PIN_LOW)
+#define LCD_RES_HIGH(lcd) rt_pin_write((lcd)->res_pin, PIN_HIGH)
+#define LCD_BLK_LOW(lcd) rt_pin_write((lcd)->blk_pin, PIN_LOW)
+#define LCD_BLK_HIGH(lcd) rt_pin_write((lcd)->blk_pin, PIN_HIGH)
 
 /* 使用lcd_rtthread.h中定义的引脚操作宏 */
 
+#ifdef PKG_ST7789_USING_ASYNC_INIT
+#define LCD_EVT_READY 0x01                                     // 初始化完成事件
+#ifdef PKG_ST_7789_INIT_THREAD_STACK
+#define LCD_INIT_THREAD_STACK PKG_ST_7789_INIT_THREAD_STACK // 初始化线程栈(on_ready在其中绘图)
+#else
+#define LCD_INIT_THREAD_STACK 4096
+#endif
+#define LCD_INIT_THREAD_PRIO (RT_THREAD_PRIORITY_MAX / 2 - 2) // 初始化线程优先级
+
+/**
+ * @brief 面板未就绪时阻塞调用者
+ * @param lcd LCD实例
+ *
+ * 功能说明：
+ * 1. 后台初始化期间其它线程的绘图调用在此排队，就绪后按唤醒顺序执行
+ * 2. 每个公开接口入口处首先调用，早于统计钩子与批量缓冲区等实例状态的访问，
+ *    初始化流量与等待时间不会记到调用者的统计/跟踪上
+ * 3. 初始化线程自身及同步挂载不受影响
+ */
+static void LCD_GateReady(lcd_st7789_t *lcd)
+{
+    if (!lcd->ready && lcd->init_tid != RT_NULL && rt_thread_self() != lcd->init_tid)
+        LCDx_WaitReady(lcd, RT_WAITING_FOREVER);
+}
+#else
+#define LCD_GateReady(lcd)
+#endif
+
+#ifdef LCD_USING_PROFILE
+#ifdef PKG_ST7789_PROFILE_USING_DWT
+#define LCD_DEMCR (*(volatile rt_uint32_t *)0xE000EDFC)      // 调试异常与监视控制寄存器
+#define LCD_DWT_CTRL (*(volatile rt_uint32_t *)0xE0001000)   // DWT控制寄存器
+#define LCD_DWT_CYCCNT (*(volatile rt_uint32_t *)0xE0001004) // DWT周期计数器
+#define LCD_PROF_NOW() LCD_DWT_CYCCNT
+extern uint32_t SystemCoreClock; // CMSIS系统时钟(Hz)
+#else
+#define LCD_PROF_NOW() rt_tick_get()
+#endif
+
+static const char *const lcd_stat_names[LCD_STAT_MAX] = {
+    "Clear",
+    "DrawPoint",
+    "DrawPoints",
+    "Fill",
+    "FillRects",
+    "Color_Fill",
+    "ShowChar",
+    "ShowString",
+    "ShowNum",
+    "ShowImage",
+    "BlitImage",
+    "ShowImageRot",
+    "Sprite",
+    "AlphaImage",
+    "Gradient",
+    "Pattern",
+    "DrawLine",
+    "DrawRect",
+    "Draw_Circle",
+    "DispFlush",
+    "DispFlushSync",
+    "FB_Flush",
+    "ReadRect",
+    "Blend",
+    "(other)",
+};
+
+/**
+ * @brief 获取接口编号名称
+ * @param id 接口编号(LCD_STAT_xxx)
+ * @return 名称，编号无效时返回"?"
+ */
+const char *LCD_StatName(u8 id)
+{
+    return id < LCD_STAT_MAX ? lcd_stat_names[id] : "?";
+}
+
+/**
+ * @brief 计时值换算为微秒
+ * @param time 计时差值(tick，使用DWT时为CPU周期)
+ * @return 微秒数(超过32位时饱和)
+ */
+rt_uint32_t LCD_ProfToUs(rt_uint64_t time)
+{
+    rt_uint64_t us;
+
+#ifdef PKG_ST7789_PROFILE_USING_DWT
+    us = time / (SystemCoreClock / 1000000);
+#else
+    us = time * 1000000 / RT_TICK_PER_SECOND;
+#endif
+    return us > 0xFFFFFFFFUL ? 0xFFFFFFFFUL : (rt_uint32_t)us;
+}
+
+#ifdef PKG_ST7789_USING_TRACE
+#ifdef PKG_ST_7789_TRACE_DEPTH
+#define LCD_TRACE_DEPTH PKG_ST_7789_TRACE_DEPTH // 跟踪环形缓冲区记录数
+#else
+#define LCD_TRACE_DEPTH 128
+#endif
+
+static lcd_trace_rec_t lcd_trace_ring[LCD_TRACE_DEPTH]; // 所有实例共用，按写入顺序覆盖最旧记录
+static rt_uint32_t lcd_trace_head;                      // 累计写入条数
+static volatile u8 lcd_trace_on = 1;                    // 1:记录
+
+/**
+ * @brief 写一条跟踪记录
+ * @param lcd LCD实例
+ * @param op 操作(LCD_STAT_xxx或LCD_TRACE_xxx)
+ * @param t0 开始时刻
+ * @param t1 结束时刻
+ * @param bytes 发送/接收字节数
+ * @param win 窗口(x, y, w, h)
+ *
+ * 功能说明：关中断占用槽位并填写，各线程、各实例的记录按完成顺序写入同一环形缓冲区
+ */
+static void LCD_TraceRecord(lcd_st7789_t *lcd, u8 op, rt_uint32_t t0, rt_uint32_t t1, rt_uint32_t bytes, const u16 *win)
+{
+    rt_thread_t self = rt_thread_self();
+    lcd_trace_rec_t *rec;
+    rt_base_t level;
+
+    if (!lcd_trace_on)
+        return;
+
+    level = rt_hw_interrupt_disable();
+    rec = &lcd_trace_ring[lcd_trace_head++ % LCD_TRACE_DEPTH];
+    rec->ts = t0;
+    rec->dur = t1 - t0;
+    rec->bytes = bytes;
+    rec->dev = lcd->spi_name;
+    if (self != RT_NULL)
+        rt_memcpy(rec->thread, ((struct rt_object *)self)->name, RT_NAME_MAX); // 4.x/5.x线程对象都以名称开头
+    else
+        rec->thread[0] = '\0';
+    rec->x = win[0];
+    rec->y = win[1];
+    rec->w = win[2];
+    rec->h = win[3];
+    rec->op = op;
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * @brief 开始/暂停记录
+ * @param enable 1开始 0暂停
+ * @return 原来的状态
+ */
+u8 LCD_TraceEnable(u8 enable)
+{
+    u8 was_on = lcd_trace_on;
+
+    lcd_trace_on = enable ? 1 : 0;
+    return was_on;
+}
+
+/**
+ * @brief 清空跟踪记录
+ */
+void LCD_TraceClear(void)
+{
+    rt_base_t level = rt_hw_interrupt_disable();
+    lcd_trace_head = 0;
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * @brief 读取跟踪记录
+ * @param start 从最旧记录起跳过的条数
+ * @param out 输出缓冲区
+ * @param max 最多读取条数
+ * @return 实际读取条数，0表示已读完
+ *
+ * 功能说明：
+ * 1. 按写入(完成)顺序从旧到新输出，环形缓冲区写满后只保留最近LCD_TRACE_DEPTH条
+ * 2. 分段读取期间应先暂停记录，否则新记录会挤掉尚未读取的旧记录
+ */
+rt_uint32_t LCD_TraceRead(rt_uint32_t start, lcd_trace_rec_t *out, rt_uint32_t max)
+{
+    rt_uint32_t head, count, oldest, n = 0;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    head = lcd_trace_head;
+    count = head < LCD_TRACE_DEPTH ? head : LCD_TRACE_DEPTH;
+    oldest = head - count;
+    while (start + n < count && n < max)
+    {
+        out[n] = lcd_trace_ring[(oldest + start + n) % LCD_TRACE_DEPTH];
+        n++;
+    }
+    rt_hw_interrupt_enable(level);
+
+    return n;
+}
+
+/**
+ * @brief 已丢弃(被覆盖)的记录条数
+ */
+rt_uint32_t LCD_TraceDropped(void)
+{
+    rt_uint32_t head = lcd_trace_head;
+
+    return head > LCD_TRACE_DEPTH ? head - LCD_TRACE_DEPTH : 0;
+}
+#endif
+
+/**
+ * @brief 进入公开接口
+ * @param lcd LCD实例
+ * @param id 接口编号(LCD_STAT_xxx)
+ *
+ * 功能说明：
+ * 1. 每次调用都计数，嵌套调用(如ShowString内的ShowChar)同样计数
+ * 2. 只有最外层接口开始计时，其间的总线传输都记在最外层接口上
+ */
+static void LCD_ProfEnter(lcd_st7789_t *lcd, u8 id)
+{
+    if (lcd->prof_mute)
+        return;
+#ifdef PKG_ST7789_USING_STATS
+    lcd->stats[id].calls++;
+#endif
+    if (lcd->prof_depth++ == 0)
+    {
+        lcd->prof_op = id;
+        lcd->prof_t0 = LCD_PROF_NOW();
+#ifdef PKG_ST7789_USING_TRACE
+        lcd->trace_bytes = 0;
+        lcd->trace_box[0] = lcd->trace_box[1] = 0xFFFF;
+        lcd->trace_box[2] = lcd->trace_box[3] = 0;
+#endif
+    }
+}
+
+/**
+ * @brief 离开公开接口
+ * @param lcd LCD实例
+ *
+ * 功能说明：最外层接口结束时累计耗时，并以期间设置过的全部窗口的外接矩形写一条跟踪记录
+ */
+static void LCD_ProfLeave(lcd_st7789_t *lcd)
+{
+    if (lcd->prof_mute || --lcd->prof_depth != 0)
+        return;
+
+#if defined(PKG_ST7789_USING_STATS) || defined(PKG_ST7789_USING_TRACE)
+    rt_uint32_t t1 = LCD_PROF_NOW();
+#endif
+#ifdef PKG_ST7789_USING_STATS
+    lcd->stats[lcd->prof_op].time += t1 - lcd->prof_t0;
+#endif
+#ifdef PKG_ST7789_USING_TRACE
+    {
+        u16 box[4] = {0, 0, 0, 0};
+
+        if (lcd->trace_box[0] <= lcd->trace_box[2])
+        {
+            box[0] = lcd->trace_box[0];
+            box[1] = lcd->trace_box[1];
+            box[2] = lcd->trace_box[2] - lcd->trace_box[0] + 1;
+            box[3] = lcd->trace_box[3] - lcd->trace_box[1] + 1;
+        }
+        LCD_TraceRecord(lcd, lcd->prof_op, lcd->prof_t0, t1, lcd->trace_bytes, box);
+    }
+#endif
+    lcd->prof_op = LCD_STAT_OTHER;
+}
+
+/**
+ * @brief 记录一次SPI传输
+ * @param lcd LCD实例
+ * @param op 传输类型(LCD_TRACE_xxx)
+ * @param bytes 字节数
+ * @param t0 传输开始时刻
+ */
+static void LCD_ProfXfer(lcd_st7789_t *lcd, u8 op, rt_uint32_t bytes, rt_uint32_t t0)
+{
+    if (lcd->prof_mute)
+        return;
+#ifdef PKG_ST7789_USING_STATS
+    lcd->stats[lcd->prof_op].bytes += bytes;
+    lcd->stats[lcd->prof_op].xfers++;
+#endif
+#ifdef PKG_ST7789_USING_TRACE
+    lcd->trace_bytes += bytes;
+    LCD_TraceRecord(lcd, op, t0, LCD_PROF_NOW(), bytes, lcd->trace_win);
+#else
+    (void)op;
+    (void)t0;
+#endif
+#ifdef PKG_ST7789_USING_OVERLAY
+    lcd->ovl_bytes += bytes;
+#endif
+}
+
+/**
+ * @brief 记录一次地址窗口设置
+ * @param lcd LCD实例
+ * @param sx 起始X坐标
+ * @param sy 起始Y坐标
+ * @param width 宽度
+ * @param height 高度
+ */
+static void LCD_ProfWindow(lcd_st7789_t *lcd, u16 sx, u16 sy, u16 width, u16 height)
+{
+    if (lcd->prof_mute)
+        return;
+#ifdef PKG_ST7789_USING_STATS
+    lcd->stats[lcd->prof_op].windows++;
+#endif
+#ifdef PKG_ST7789_USING_TRACE
+    lcd->trace_win[0] = sx;
+    lcd->trace_win[1] = sy;
+    lcd->trace_win[2] = width;
+    lcd->trace_win[3] = height;
+    if (sx < lcd->trace_box[0])
+        lcd->trace_box[0] = sx;
+    if (sy < lcd->trace_box[1])
+        lcd->trace_box[1] = sy;
+    if (sx + width - 1 > lcd->trace_box[2])
+        lcd->trace_box[2] = sx + width - 1;
+    if (sy + height - 1 > lcd->trace_box[3])
+        lcd->trace_box[3] = sy + height - 1;
+#else
+    (void)sx;
+    (void)sy;
+    (void)width;
+    (void)height;
+#endif
+}
+
+#define LCD_PROF_ENTER(lcd, id) LCD_ProfEnter(lcd, id)
+#define LCD_PROF_LEAVE(lcd) LCD_ProfLeave(lcd)
+#ifdef PKG_ST7789_USING_TRACE
+#define LCD_PROF_T0(t) rt_uint32_t t = LCD_PROF_NOW()
+#else
+#define LCD_PROF_T0(t) const rt_uint32_t t = 0 // 传输开始时刻只有跟踪使用，不读计时器
+#endif
+#define LCD_PROF_XFER(lcd, op, bytes, t0) LCD_ProfXfer(lcd, op, bytes, t0)
+#define LCD_PROF_WINDOW(lcd, sx, sy, w, h) LCD_ProfWindow(lcd, sx, sy, w, h)
+#else
+#define LCD_PROF_ENTER(lcd, id)
+#define LCD_PROF_LEAVE(lcd)
+#define LCD_PROF_T0(t)
+#define LCD_PROF_XFER(lcd, op, bytes, t0)
+#define LCD_PROF_WINDOW(lcd, sx, sy, w, h)
+#endif
+
+/**
+ * @brief 发送数据并计入统计/跟踪
+ * @param lcd LCD实例
+ * @param buf 数据
+ * @param len 字节数
+ */
+static void LCD_SpiSend(lcd_st7789_t *lcd, const void *buf, rt_size_t len)
+{
+    LCD_PROF_T0(t0);
+
+    // 发送批量缓冲区中的内容说明其已被改写，单色填充记录失效
+    if ((const u8 *)buf >= lcd->batch && (const u8 *)buf < lcd->batch + LCD_BATCH_BUFFER_SIZE)
+        lcd->fill_count = 0;
+    rt_spi_send(lcd->spi, buf, len);
+    LCD_PROF_XFER(lcd, LCD_TRACE_DATA, len, t0);
+}
+
 /* 移植后的SPI接口函数 */
 /**
  * @brief 写LCD寄存器命令
+ * @param lcd LCD实例
  * @param reg 寄存器地址/命令
  *
  * 功能说明：
@@ -50,29 +508,72 @@ static struct rt_spi_device *lcd_dev;
  * 2. 通过SPI发送命令字节
  * 3. 拉高DC线恢复数据模式
  */
-static void LCD_WR_REG(uint8_t reg)
+static void LCD_WR_REG(lcd_st7789_t *lcd, uint8_t reg)
 {
-    LCD_DC_CLR;
-    rt_spi_send(lcd_dev, &reg, 1);
-    LCD_DC_SET;
+    LCD_PROF_T0(t0);
+    LCD_DC_LOW(lcd);
+    rt_spi_send(lcd->spi, &reg, 1);
+    LCD_DC_HIGH(lcd);
+    LCD_PROF_XFER(lcd, LCD_TRACE_CMD, 1, t0);
 }
 
 /**
- * @brief 写LCD数据(8位)
- * @param data 要写入的数据
+ * @brief 写命令及其参数
+ * @param lcd LCD实例
+ * @param cmd 命令
+ * @param data 参数，len为0时可为RT_NULL
+ * @param len 参数字节数
  *
  * 功能说明：
- * 1. 保持DC线为高表示写数据
- * 2. 通过SPI发送单字节数据
+ * 1. 命令与全部参数在同一次片选内发送，DC在两段之间切换
+ * 2. 参数整段一次发送，不再逐字节调用rt_spi_send
+ */
+static void LCD_WR_CMD(lcd_st7789_t *lcd, u8 cmd, const u8 *data, u8 len)
+{
+    struct rt_spi_message msg_cmd, msg_data;
+
+    msg_cmd.send_buf = &cmd;
+    msg_cmd.recv_buf = RT_NULL;
+    msg_cmd.length = 1;
+    msg_cmd.cs_take = 1;
+    msg_cmd.cs_release = (len == 0);
+    msg_cmd.next = RT_NULL;
+
+    msg_data.send_buf = data;
+    msg_data.recv_buf = RT_NULL;
+    msg_data.length = len;
+    msg_data.cs_take = 0;
+    msg_data.cs_release = 1;
+    msg_data.next = RT_NULL;
+
+    LCD_PROF_T0(t0);
+    rt_spi_take_bus(lcd->spi);
+    LCD_DC_LOW(lcd);
+    rt_spi_transfer_message(lcd->spi, &msg_cmd);
+    LCD_DC_HIGH(lcd);
+    if (len)
+        rt_spi_transfer_message(lcd->spi, &msg_data);
+    rt_spi_release_bus(lcd->spi);
+    LCD_PROF_XFER(lcd, LCD_TRACE_CMD, 1 + len, t0);
+}
+
+/**
+ * @brief 写地址范围(CASET/RASET/PTLAR)
+ * @param lcd LCD实例
+ * @param cmd 命令
+ * @param start 起始地址
+ * @param end 结束地址
  */
-static void LCD_WR_DATA(uint8_t data)
+static void LCD_WR_ADDR(lcd_st7789_t *lcd, u8 cmd, u16 start, u16 end)
 {
-    LCD_DC_SET;
-    rt_spi_send(lcd_dev, &data, 1);
+    u8 buf[4] = {start >> 8, start & 0xFF, end >> 8, end & 0xFF};
+
+    LCD_WR_CMD(lcd, cmd, buf, 4);
 }
 
 /**
  * @brief 写LCD数据(16位)
+ * @param lcd LCD实例
  * @param data 要写入的16位数据
  *
  * 功能说明：
@@ -80,169 +581,211 @@ static void LCD_WR_DATA(uint8_t data)
  * 2. 将16位数据拆分为高低字节
  * 3. 通过SPI发送两个字节
  */
-static void LCD_WR_DATA_16BIT(uint16_t data)
+static void LCD_WR_DATA_16BIT(lcd_st7789_t *lcd, uint16_t data)
 {
     uint8_t buf[2] = {data >> 8, data & 0xFF};
-    LCD_DC_SET;
-    rt_spi_send(lcd_dev, buf, 2);
+    LCD_DC_HIGH(lcd);
+    LCD_SpiSend(lcd, buf, 2);
 }
 
 /* 新增GRAM操作函数 */
 /**
  * @brief 写GRAM数据
+ * @param lcd LCD实例
  * @param RGB_Code RGB565格式颜色值
  *
  * 功能说明：
  * 1. 调用16位数据写入函数
  * 2. 用于连续写入GRAM数据
  */
-static void LCD_WriteRAM(uint16_t RGB_Code)
+static void LCD_WriteRAM(lcd_st7789_t *lcd, uint16_t RGB_Code)
 {
-    LCD_WR_DATA_16BIT(RGB_Code);
+    LCD_WR_DATA_16BIT(lcd, RGB_Code);
 }
 
 /**
  * @brief 准备GRAM写入
+ * @param lcd LCD实例
  *
  * 功能说明：
  * 1. 发送GRAM写入命令
  * 2. 必须在连续写入GRAM数据前调用
  */
-static void LCD_WriteRAM_Prepare(void)
+static void LCD_WriteRAM_Prepare(lcd_st7789_t *lcd)
 {
-    LCD_WR_REG(lcddev.wramcmd);
+    LCD_WR_REG(lcd, lcd->dev->wramcmd);
 }
 
 /**
  * @brief 写LCD寄存器值
+ * @param lcd LCD实例
  * @param LCD_Reg 寄存器地址
  * @param LCD_RegValue 要写入的寄存器值
  *
  * 功能说明：
  * 1. 先写寄存器地址
- * 2. 再写寄存器值(16位)
+ * 2. 再写寄存器值(低8位)
+ */
+static void LCD_WriteReg(lcd_st7789_t *lcd, uint8_t LCD_Reg, uint16_t LCD_RegValue)
+{
+    u8 val = LCD_RegValue;
+
+    LCD_WR_CMD(lcd, LCD_Reg, &val, 1);
+}
+
+#ifdef PKG_ST7789_USING_READ
+/**
+ * @brief 修改SPI时钟
+ * @param lcd LCD实例
+ * @param hz 目标时钟(Hz)，实际频率由BSP向下取整到可用分频
+ */
+static void LCD_SPI_SetHz(lcd_st7789_t *lcd, rt_uint32_t hz)
+{
+    struct rt_spi_configuration cfg = lcd->spi->config;
+
+    cfg.max_hz = hz;
+    rt_spi_configure(lcd->spi, &cfg);
+}
+
+/**
+ * @brief 读LCD寄存器/GRAM数据
+ * @param lcd LCD实例
+ * @param cmd 读命令
+ * @param buf 接收缓冲区
+ * @param len 有效数据字节数
+ * @param dummy_bits 命令后的空周期位数(RDDID为1，RAMRD为8)
+ * @return RT_EOK成功
+ *
+ * 功能说明：
+ * 1. 在同一次片选内先发命令(DC低)再读数据(DC高)
+ * 2. 读取期间SPI切到读时钟，结束后恢复写时钟
+ * 3. 按空周期位数把接收数据整体左移对齐
+ *
+ * 注意：buf需至少len+1字节
+ */
+static rt_err_t LCD_ReadData(lcd_st7789_t *lcd, uint8_t cmd, uint8_t *buf, rt_uint32_t len, uint8_t dummy_bits)
+{
+    struct rt_spi_message msg_cmd, msg_data;
+    rt_uint32_t extra = (dummy_bits + 7) / 8;
+    uint8_t shift = dummy_bits % 8;
+    rt_uint32_t i;
+
+    LCD_PROF_T0(t0);
+    lcd->fill_count = 0; // 回读可能写入批量缓冲区
+    rt_spi_take_bus(lcd->spi);
+    LCD_SPI_SetHz(lcd, LCD_SPI_READ_HZ);
+
+    msg_cmd.send_buf = &cmd;
+    msg_cmd.recv_buf = RT_NULL;
+    msg_cmd.length = 1;
+    msg_cmd.cs_take = 1;
+    msg_cmd.cs_release = 0;
+    msg_cmd.next = RT_NULL;
+
+    msg_data.send_buf = RT_NULL;
+    msg_data.recv_buf = buf;
+    msg_data.length = len + extra;
+    msg_data.cs_take = 0;
+    msg_data.cs_release = 1;
+    msg_data.next = RT_NULL;
+
+    LCD_DC_LOW(lcd);
+    rt_spi_transfer_message(lcd->spi, &msg_cmd);
+    LCD_DC_HIGH(lcd);
+    rt_spi_transfer_message(lcd->spi, &msg_data);
+
+    LCD_SPI_SetHz(lcd, lcd->spi_hz);
+    rt_spi_release_bus(lcd->spi);
+    LCD_PROF_XFER(lcd, LCD_TRACE_READ, 1 + len + extra, t0);
+
+    // 去掉空周期：整字节直接跳过，剩余位数整体左移
+    if (shift == 0)
+    {
+        if (extra)
+            rt_memmove(buf, buf + extra, len);
+    }
+    else
+    {
+        uint8_t *src = buf + extra - 1;
+        for (i = 0; i < len; i++)
+            buf[i] = (src[i] << shift) | (src[i + 1] >> (8 - shift));
+    }
+
+    return RT_EOK;
+}
+#endif
+
+/**
+ * @brief 执行初始化序列表
+ * @param lcd LCD实例
+ * @param seq 序列表
+ *
+ * 功能说明：每条命令连同参数一次片选发送，按表项延时
+ */
+static void LCD_RunSeq(lcd_st7789_t *lcd, const u8 *seq)
+{
+    while (seq[0] != LCD_SEQ_END)
+    {
+        LCD_WR_CMD(lcd, seq[0], &seq[3], seq[1]);
+        if (seq[2])
+            rt_thread_mdelay(seq[2]);
+        seq += 3 + seq[1];
+    }
+}
+
+/**
+ * @brief 按保存的门廊参数写PORCTRL
+ * @param lcd LCD实例
  */
-static void LCD_WriteReg(uint8_t LCD_Reg, uint16_t LCD_RegValue)
+static void LCD_WritePorch(lcd_st7789_t *lcd)
 {
-    LCD_WR_REG(LCD_Reg);
-    LCD_WR_DATA(LCD_RegValue);
+    u8 buf[5] = {lcd->timing.bpa, lcd->timing.fpa, 0x00, 0x33, 0x33}; // PSEN=0: 空闲/局部模式沿用正常模式门廊
+
+    LCD_WR_CMD(lcd, 0xb2, buf, 5);
 }
 
-/* 保留lcd.c中的初始化命令序列 */
-static void LCD_INIT_CODE(u8 dir)
+/**
+ * @brief 执行面板初始化
+ * @param lcd LCD实例
+ * @param dir 方向(0-竖屏,1-横屏)
+ *
+ * 功能说明：
+ * 1. 执行面板型号的初始化序列表
+ * 2. 按保存的参数写门廊与帧率，设置方向后开启显示
+ */
+static void LCD_INIT_CODE(lcd_st7789_t *lcd, u8 dir)
 {
     // LCD_BLK_CLR;
-    LCD_WR_REG(0x11);
-    rt_thread_mdelay(120); // Delay 120ms
-    //------------------------------display and color format setting--------------------------------//
-    LCD_WR_REG(0x36);
-    LCD_WR_DATA(0x00);
-
-    LCD_WR_REG(0x3a);
-    LCD_WR_DATA(0x05);
-    //--------------------------------ST7789V Frame rate setting----------------------------------//
-    LCD_WR_REG(0xb2);
-    LCD_WR_DATA(0x0c);
-    LCD_WR_DATA(0x0c);
-    LCD_WR_DATA(0x00);
-    LCD_WR_DATA(0x33);
-    LCD_WR_DATA(0x33);
-    LCD_Display_Dir(dir);
-    LCD_WR_REG(0xb7);
-    LCD_WR_DATA(0x35);
-    //---------------------------------ST7789V Power setting--------------------------------------//
-    LCD_WR_REG(0xbb);
-    LCD_WR_DATA(0x28);
-    LCD_WR_REG(0xc0);
-    LCD_WR_DATA(0x2c);
-    LCD_WR_REG(0xc2);
-    LCD_WR_DATA(0x01);
-    LCD_WR_REG(0xc3);
-    LCD_WR_DATA(0x10);
-    LCD_WR_REG(0xc4);
-    LCD_WR_DATA(0x20);
-    LCD_WR_REG(0xc6);
-    LCD_WR_DATA(0x0f);
-    LCD_WR_REG(0xd0);
-    LCD_WR_DATA(0xa4);
-    LCD_WR_DATA(0xa1);
-    //--------------------------------ST7789V gamma setting---------------------------------------//
-    // 0xD0, 0x04, 0x0D, 0x11, 0x13, 0x2B, 0x3F, 0x54, 0x4C, 0x18, 0x0D, 0x0B, 0x1F, 0x23
-    LCD_WR_REG(0xe0);
-    LCD_WR_DATA(0xd0);
-    LCD_WR_DATA(0x00);
-    LCD_WR_DATA(0x02);
-    LCD_WR_DATA(0x07);
-    LCD_WR_DATA(0x0a);
-    LCD_WR_DATA(0x28);
-    LCD_WR_DATA(0x32);
-    LCD_WR_DATA(0x44);
-    LCD_WR_DATA(0x42);
-    LCD_WR_DATA(0x06);
-    LCD_WR_DATA(0x0e);
-    LCD_WR_DATA(0x12);
-    LCD_WR_DATA(0x14);
-    LCD_WR_DATA(0x17);
-    // 0xD0, 0x04, 0x0C, 0x11, 0x13, 0x2C, 0x3F, 0x44, 0x51, 0x2F, 0x1F, 0x1F, 0x20, 0x23
-    LCD_WR_REG(0xe1);
-    LCD_WR_DATA(0xd0);
-    LCD_WR_DATA(0x00);
-    LCD_WR_DATA(0x02);
-    LCD_WR_DATA(0x07);
-    LCD_WR_DATA(0x0a);
-    LCD_WR_DATA(0x28);
-    LCD_WR_DATA(0x31);
-    LCD_WR_DATA(0x54);
-    LCD_WR_DATA(0x47);
-    LCD_WR_DATA(0x0e);
-    LCD_WR_DATA(0x1c);
-    LCD_WR_DATA(0x17);
-    LCD_WR_DATA(0x1b);
-    LCD_WR_DATA(0x1e);
-    LCD_WR_REG(0x29);
+    LCD_RunSeq(lcd, lcd->panel ? lcd->panel->init_seq : lcd_seq_tn);
+    LCD_WritePorch(lcd);
+    LCD_WriteReg(lcd, 0xc6, lcd->timing.rtna);
+    LCDx_Display_Dir(lcd, dir);
+    LCD_WR_CMD(lcd, 0x29, RT_NULL, 0); // DISPON
 }
 
 /**
  * @brief 设置光标位置
+ * @param lcd LCD实例
  * @param Xpos X坐标
  * @param Ypos Y坐标
  *
  * 功能说明：
  * 1. 设置X方向光标位置
  * 2. 设置Y方向光标位置
- * 3. 使用批量传输提高效率
+ * 3. 叠加当前方向的GRAM偏移，命令与坐标一次片选发送
  */
-void LCD_SetCursor(uint16_t Xpos, uint16_t Ypos)
+void LCDx_SetCursor(lcd_st7789_t *lcd, uint16_t Xpos, uint16_t Ypos)
 {
-
-    // X坐标设置缓冲区
-    uint8_t x_buf[4];
-    x_buf[0] = Xpos >> 8;
-    x_buf[1] = Xpos & 0X00FF;
-    x_buf[2] = Xpos >> 8;
-    x_buf[3] = Xpos & 0X00FF;
-
-    // Y坐标设置缓冲区
-    uint8_t y_buf[4];
-    y_buf[0] = Ypos >> 8;
-    y_buf[1] = Ypos & 0X000FF;
-    y_buf[2] = Ypos >> 8;
-    y_buf[3] = Ypos & 0X00FF;
-
-    // 发送X坐标命令和数据
-    LCD_WR_REG(lcddev.setxcmd);
-    LCD_DC_SET;
-    rt_spi_send(lcd_dev, x_buf, 4);
-
-    // 发送Y坐标命令和数据
-    LCD_WR_REG(lcddev.setycmd);
-    LCD_DC_SET;
-    rt_spi_send(lcd_dev, y_buf, 4);
+    LCD_GateReady(lcd);
+    LCD_PROF_WINDOW(lcd, Xpos, Ypos, 1, 1);
+    LCD_WR_ADDR(lcd, lcd->dev->setxcmd, Xpos + lcd->x_off, Xpos + lcd->x_off);
+    LCD_WR_ADDR(lcd, lcd->dev->setycmd, Ypos + lcd->y_off, Ypos + lcd->y_off);
 }
 
 
 /**
  * @brief 设置LCD显示窗口
+ * @param lcd LCD实例
  * @param sx 起始X坐标
  * @param sy 起始Y坐标
  * @param width 窗口宽度
@@ -251,42 +794,22 @@ void LCD_SetCursor(uint16_t Xpos, uint16_t Ypos)
  * 功能说明：
  * 1. 设置X方向起始和结束地址
  * 2. 设置Y方向起始和结束地址
- * 3. 使用批量传输提高效率
+ * 3. 叠加当前方向的GRAM偏移，命令与坐标一次片选发送
  */
-static void LCD_SetWindows(uint16_t sx, uint16_t sy, uint16_t width, uint16_t height)
+static void LCD_SetWindows(lcd_st7789_t *lcd, uint16_t sx, uint16_t sy, uint16_t width, uint16_t height)
 {
-
     uint16_t ex = sx + width - 1;  // 结束X坐标
     uint16_t ey = sy + height - 1; // 结束Y坐标
 
-    // X坐标设置缓冲区
-    uint8_t x_buf[4];
-    x_buf[0] = sx >> 8;     // 起始X高字节
-    x_buf[1] = sx & 0X00FF; // 起始X低字节
-    x_buf[2] = ex >> 8;     // 结束X高字节
-    x_buf[3] = ex & 0X00FF; // 结束X低字节
-
-    // Y坐标设置缓冲区
-    uint8_t y_buf[4];
-    y_buf[0] = sy >> 8;     // 起始Y高字节
-    y_buf[1] = sy & 0X00FF; // 起始Y低字节
-    y_buf[2] = ey >> 8;     // 结束Y高字节
-    y_buf[3] = ey & 0X00FF; // 结束Y低字节
-
-    // 发送X坐标命令和数据
-    LCD_WR_REG(lcddev.setxcmd);
-    LCD_DC_SET;
-    rt_spi_send(lcd_dev, x_buf, 4);
-
-    // 发送Y坐标命令和数据
-    LCD_WR_REG(lcddev.setycmd);
-    LCD_DC_SET;
-    rt_spi_send(lcd_dev, y_buf, 4);
+    LCD_PROF_WINDOW(lcd, sx, sy, width, height);
+    LCD_WR_ADDR(lcd, lcd->dev->setxcmd, sx + lcd->x_off, ex + lcd->x_off);
+    LCD_WR_ADDR(lcd, lcd->dev->setycmd, sy + lcd->y_off, ey + lcd->y_off);
 }
 
 /* 兼容旧接口 */
 /**
  * @brief 设置显示窗口(兼容旧接口)
+ * @param lcd LCD实例
  * @param sx 起始X坐标
  * @param sy 起始Y坐标
  * @param ex 结束X坐标
@@ -296,93 +819,263 @@ static void LCD_SetWindows(uint16_t sx, uint16_t sy, uint16_t width, uint16_t he
  * 1. 转换为宽度/高度格式
  * 2. 调用新式窗口设置函数
  */
-static void LCD_SetWindow(u16 sx, u16 sy, u16 ex, u16 ey)
+static void LCD_SetWindow(lcd_st7789_t *lcd, u16 sx, u16 sy, u16 ex, u16 ey)
 {
-    LCD_SetWindows(sx, sy, ex - sx + 1, ey - sy + 1);
+    LCD_SetWindows(lcd, sx, sy, ex - sx + 1, ey - sy + 1);
 }
 
 /**
- * @brief 清屏函数
- * @param Color 填充颜色(RGB565)
- *
- * 功能说明：
- * 1. 设置全屏窗口
- * 2. 使用批量传输模式
- * 3. 用于快速清屏
+ * @brief 设置接口像素格式(COLMOD)
+ * @param lcd LCD实例
+ * @param fmt LCD_PIXFMT_RGB565或LCD_PIXFMT_RGB444
  */
-void LCD_Clear(uint16_t Color)
+static void LCD_SetColmod(lcd_st7789_t *lcd, u8 fmt)
 {
+    LCD_WriteReg(lcd, 0x3a, fmt);
+}
 
-    uint32_t index, i;
-    uint32_t total = lcddev.width * lcddev.height;
-    uint32_t batch_size = LCD_BATCH_BUFFER_SIZE / 2; // 每批次处理的像素数量(2字节/像素)
+/**
+ * @brief 判断本次批量传输是否使用12位格式
+ * @param lcd LCD实例
+ * @param total 像素总数
+ * @return 1-使用RGB444 0-使用RGB565
+ */
+static int LCD_Use444(lcd_st7789_t *lcd, u32 total)
+{
+    return lcd->bulk_fmt == LCD_PIXFMT_RGB444 && total >= LCD_RGB444_MIN_PIXELS;
+}
 
-    // 设置清屏窗口(全屏)
-    LCD_SetWindows(0, 0, lcddev.width, lcddev.height);
-    LCD_WriteRAM_Prepare(); // 开始写入GRAM
+/**
+ * @brief RGB565转RGB444打包
+ * @param dst 目标字节流
+ * @param src RGB565像素
+ * @param count 像素数
+ * @return 写入的字节数
+ *
+ * 功能说明：
+ * 1. 每2个像素打包为3字节：R0G0 B0R1 G1B1
+ * 2. 每分量直接截取高4位，无需查表
+ * 3. 奇数个像素时最后一个像素占2字节(低4位填0)
+ */
+static u32 LCD_Pack444(u8 *dst, const u16 *src, u32 count)
+{
+    u8 *d = dst;
+    u32 pairs = count >> 1;
 
-    // 预填充数据缓冲区
-    for (i = 0; i < batch_size && i < LCD_BATCH_BUFFER_SIZE / 2; i++)
+    while (pairs--)
+    {
+        u16 a = *src++;
+        u16 b = *src++;
+        d[0] = ((a >> 8) & 0xF0) | ((a >> 7) & 0x0F); // R0 G0
+        d[1] = ((a << 3) & 0xF0) | (b >> 12);         // B0 R1
+        d[2] = ((b >> 3) & 0xF0) | ((b >> 1) & 0x0F); // G1 B1
+        d += 3;
+    }
+    if (count & 1)
     {
-        batch_buffer[i * 2] = Color >> 8;       // 高字节
-        batch_buffer[i * 2 + 1] = Color & 0xFF; // 低字节
+        u16 a = *src;
+        d[0] = ((a >> 8) & 0xF0) | ((a >> 7) & 0x0F);
+        d[1] = (a << 3) & 0xF0;
+        d += 2;
     }
 
-    LCD_DC_SET; // 设置为数据模式
+    return d - dst;
+}
+
+/**
+ * @brief 以RGB444格式发送单色数据
+ * @param lcd LCD实例
+ * @param total 像素总数
+ * @param color 颜色(RGB565)
+ *
+ * 功能说明：
+ * 1. 须已设置窗口并发送写GRAM命令
+ * 2. 预填充3字节循环图案，分批发送
+ */
+static void LCD_Fill444(lcd_st7789_t *lcd, u32 total, u16 color)
+{
+    u16 pair[2] = {color, color};
+    u32 i, batch;
 
-    // 分批次发送数据
-    for (index = 0; index < total; index += batch_size)
+    LCD_Pack444(lcd->batch, pair, 2);
+    for (i = 3; i < LCD_RGB444_BATCH_PIXELS / 2 * 3; i += 3)
     {
-        // 计算当前批次实际发送的像素数
-        uint32_t current_batch = (index + batch_size > total) ? (total - index) : batch_size;
+        lcd->batch[i] = lcd->batch[0];
+        lcd->batch[i + 1] = lcd->batch[1];
+        lcd->batch[i + 2] = lcd->batch[2];
+    }
 
-        // 发送批量数据
-        rt_spi_send(lcd_dev, batch_buffer, current_batch * 2); // 每像素2字节
+    for (i = 0; i < total; i += batch)
+    {
+        batch = (i + LCD_RGB444_BATCH_PIXELS > total) ? (total - i) : LCD_RGB444_BATCH_PIXELS;
+        LCD_SpiSend(lcd, lcd->batch, (batch >> 1) * 3 + ((batch & 1) ? 2 : 0));
     }
 }
 
-/* 移植图形绘制函数 */
 /**
- * @brief 在指定位置画点
- * @param x X坐标
- * @param y Y坐标
- * @param color 点的颜色(RGB565)
+ * @brief 以RGB444格式发送像素数据
+ * @param lcd LCD实例
+ * @param p 像素数据(RGB565)
+ * @param total 像素总数
  *
  * 功能说明：
- * 1. 设置光标位置
- * 2. 准备GRAM写入
- * 3. 写入颜色数据
+ * 1. 须已设置窗口并发送写GRAM命令
+ * 2. 逐批打包后发送，每批像素数为偶数保证打包对齐
  */
-void LCD_DrawPoint(u16 x, u16 y, u16 color)
+static void LCD_Flush444(lcd_st7789_t *lcd, const u16 *p, u32 total)
 {
+    u32 i, batch;
 
-    LCD_SetCursor(x, y);
-    LCD_WriteRAM_Prepare();
-    LCD_WriteRAM(color);
+    for (i = 0; i < total; i += batch)
+    {
+        batch = (i + LCD_RGB444_BATCH_PIXELS > total) ? (total - i) : LCD_RGB444_BATCH_PIXELS;
+        LCD_SpiSend(lcd, lcd->batch, LCD_Pack444(lcd->batch, p + i, batch));
+    }
 }
 
 /**
- * @brief 批量绘制多个点
- * @param points_x X坐标数组
- * @param points_y Y坐标数组
- * @param point_count 点的数量
- * @param color 点的颜色(RGB565)
+ * @brief 设置批量传输像素格式
+ * @param lcd LCD实例
+ * @param fmt LCD_PIXFMT_RGB565(默认)或LCD_PIXFMT_RGB444
  *
  * 功能说明：
- * 1. 根据点的位置对临近点进行分组
- * 2. 按组进行批量绘制
- * 3. 显著提高多点绘制效率
+ * 1. RGB444模式下LCD_Clear/LCD_Fill/LCD_ShowImage/LCD_DispFlush
+ *    在传输前把COLMOD切到12位，每像素1.5字节，传输后切回16位
+ * 2. SPI字节数减少25%，带宽受限的全屏动画帧率约提高33%
+ * 3. 代价是每个颜色分量只保留高4位
+ * 4. 少于64像素的小区域仍用RGB565，避免COLMOD切换开销
  */
-void LCD_DrawPoints(u16 *points_x, u16 *points_y, u16 point_count, u16 color)
+void LCDx_SetBulkFormat(lcd_st7789_t *lcd, u8 fmt)
 {
+    LCD_GateReady(lcd);
+    lcd->bulk_fmt = (fmt == LCD_PIXFMT_RGB444) ? LCD_PIXFMT_RGB444 : LCD_PIXFMT_RGB565;
+}
 
-    if (point_count == 0)
+/**
+ * @brief 以单色流式发送像素
+ * @param lcd LCD实例(窗口已设置，处于数据模式)
+ * @param total 像素数
+ * @param color 颜色(RGB565)
+ *
+ * 功能说明：
+ * 1. 记录批量缓冲区开头已填好的颜色和像素数，同色且足够时直接发送，不再重复填充
+ * 2. 只填充本次传输需要的像素数(最多一个缓冲区)，每次写入一个32位字(2像素)
+ * 3. 其他接口发送或回读批量缓冲区时由LCD_SpiSend/LCD_ReadData清除记录
+ */
+static void LCD_FillStream(lcd_st7789_t *lcd, u32 total, u16 color)
+{
+    u32 need = (total < LCD_BATCH_BUFFER_SIZE / 2) ? total : LCD_BATCH_BUFFER_SIZE / 2;
+    u32 *words = (u32 *)lcd->batch;
+    u16 wire = LCD_TO_WIRE16(color);
+    u32 have, pattern, i, n;
+
+    have = (lcd->fill_wire == wire) ? lcd->fill_count : 0;
+    if (have < need)
+    {
+        pattern = wire | ((u32)wire << 16);
+        for (i = have / 2; i < (need + 1) / 2; i++)
+            words[i] = pattern;
+        have = (need + 1) & ~1UL;
+    }
+
+    for (i = 0; i < total; i += n)
+    {
+        n = (total - i < need) ? total - i : need;
+        LCD_SpiSend(lcd, lcd->batch, n * 2);
+    }
+    lcd->fill_wire = wire;
+    lcd->fill_count = have;
+}
+
+/**
+ * @brief 清屏函数
+ * @param lcd LCD实例
+ * @param Color 填充颜色(RGB565)
+ *
+ * 功能说明：
+ * 1. 设置全屏窗口
+ * 2. 使用批量传输模式
+ * 3. 用于快速清屏
+ */
+void LCDx_Clear(lcd_st7789_t *lcd, uint16_t Color)
+{
+
+    uint32_t total;
+
+    LCD_GateReady(lcd);
+    total = lcd->dev->width * lcd->dev->height;
+    LCD_PROF_ENTER(lcd, LCD_STAT_CLEAR);
+
+    // 设置清屏窗口(全屏)
+    if (LCD_Use444(lcd, total))
+    {
+        LCD_SetColmod(lcd, LCD_PIXFMT_RGB444);
+        LCD_SetWindows(lcd, 0, 0, lcd->dev->width, lcd->dev->height);
+        LCD_WriteRAM_Prepare(lcd);
+        LCD_DC_HIGH(lcd);
+        LCD_Fill444(lcd, total, Color);
+        LCD_SetColmod(lcd, LCD_PIXFMT_RGB565);
+        LCD_PROF_LEAVE(lcd);
+        return;
+    }
+    LCD_SetWindows(lcd, 0, 0, lcd->dev->width, lcd->dev->height);
+    LCD_WriteRAM_Prepare(lcd); // 开始写入GRAM
+    LCD_DC_HIGH(lcd);          // 设置为数据模式
+    LCD_FillStream(lcd, total, Color);
+    LCD_PROF_LEAVE(lcd);
+}
+
+/* 移植图形绘制函数 */
+/**
+ * @brief 在指定位置画点
+ * @param lcd LCD实例
+ * @param x X坐标
+ * @param y Y坐标
+ * @param color 点的颜色(RGB565)
+ *
+ * 功能说明：
+ * 1. 设置光标位置
+ * 2. 准备GRAM写入
+ * 3. 写入颜色数据
+ */
+void LCDx_DrawPoint(lcd_st7789_t *lcd, u16 x, u16 y, u16 color)
+{
+
+    LCD_GateReady(lcd);
+    LCD_PROF_ENTER(lcd, LCD_STAT_POINT);
+    LCDx_SetCursor(lcd, x, y);
+    LCD_WriteRAM_Prepare(lcd);
+    LCD_WriteRAM(lcd, color);
+    LCD_PROF_LEAVE(lcd);
+}
+
+/**
+ * @brief 批量绘制多个点
+ * @param lcd LCD实例
+ * @param points_x X坐标数组
+ * @param points_y Y坐标数组
+ * @param point_count 点的数量
+ * @param color 点的颜色(RGB565)
+ *
+ * 功能说明：
+ * 1. 根据点的位置对临近点进行分组
+ * 2. 按组进行批量绘制
+ * 3. 显著提高多点绘制效率
+ */
+void LCDx_DrawPoints(lcd_st7789_t *lcd, u16 *points_x, u16 *points_y, u16 point_count, u16 color)
+{
+
+    LCD_GateReady(lcd);
+    if (point_count == 0)
         return;
 
+    LCD_PROF_ENTER(lcd, LCD_STAT_POINTS);
+
     // 如果只有一个点，直接调用单点绘制
     if (point_count == 1)
     {
-        LCD_DrawPoint(points_x[0], points_y[0], color);
+        LCDx_DrawPoint(lcd, points_x[0], points_y[0], color);
+        LCD_PROF_LEAVE(lcd);
         return;
     }
 
@@ -395,7 +1088,7 @@ void LCD_DrawPoints(u16 *points_x, u16 *points_y, u16 point_count, u16 color)
     for (i = 0; i < point_count; i++)
     {
         // 跳过超出屏幕范围的点
-        if (points_x[i] >= lcddev.width || points_y[i] >= lcddev.height)
+        if (points_x[i] >= lcd->dev->width || points_y[i] >= lcd->dev->height)
             continue;
 
         // 添加点到批处理队列
@@ -428,14 +1121,14 @@ void LCD_DrawPoints(u16 *points_x, u16 *points_y, u16 point_count, u16 color)
                 // 对于长度大于1的水平线段，使用Fill函数
                 if (run_length > 1)
                 {
-                    LCD_Fill(batch_x[start_idx], batch_y[start_idx],
+                    LCDx_Fill(lcd, batch_x[start_idx], batch_y[start_idx],
                              batch_x[start_idx + run_length - 1], batch_y[start_idx],
                              color);
                 }
                 else
                 {
                     // 单个点使用普通绘制
-                    LCD_DrawPoint(batch_x[start_idx], batch_y[start_idx], color);
+                    LCDx_DrawPoint(lcd, batch_x[start_idx], batch_y[start_idx], color);
                 }
 
                 start_idx += run_length;
@@ -444,10 +1137,12 @@ void LCD_DrawPoints(u16 *points_x, u16 *points_y, u16 point_count, u16 color)
             batch_count = 0; // 重置批次计数
         }
     }
+    LCD_PROF_LEAVE(lcd);
 }
 
 /**
  * @brief 在指定区域填充单色
+ * @param lcd LCD实例
  * @param sx 起始X坐标
  * @param sy 起始Y坐标
  * @param ex 结束X坐标
@@ -459,43 +1154,207 @@ void LCD_DrawPoints(u16 *points_x, u16 *points_y, u16 point_count, u16 color)
  * 2. 使用批量传输填充颜色
  * 3. 优化性能，减少SPI传输次数
  */
-void LCD_Fill(u16 sx, u16 sy, u16 ex, u16 ey, u16 color)
+void LCDx_Fill(lcd_st7789_t *lcd, u16 sx, u16 sy, u16 ex, u16 ey, u16 color)
 {
 
     u16 width = ex - sx + 1;    // 填充宽度
     u16 height = ey - sy + 1;   // 填充高度
     u32 total = width * height; // 总像素数
-    u32 batch_size, i;
+
+    LCD_GateReady(lcd);
+    LCD_PROF_ENTER(lcd, LCD_STAT_FILL);
+
+    // 大区域使用12位格式传输
+    if (LCD_Use444(lcd, total))
+    {
+        LCD_SetColmod(lcd, LCD_PIXFMT_RGB444);
+        LCD_SetWindows(lcd, sx, sy, width, height);
+        LCD_WriteRAM_Prepare(lcd);
+        LCD_DC_HIGH(lcd);
+        LCD_Fill444(lcd, total, color);
+        LCD_SetColmod(lcd, LCD_PIXFMT_RGB565);
+        LCD_PROF_LEAVE(lcd);
+        return;
+    }
 
     // 设置填充窗口
-    LCD_SetWindows(sx, sy, width, height);
-    LCD_WriteRAM_Prepare(); // 准备写入GRAM
-    LCD_DC_SET;             // 设置为数据模式
+    LCD_SetWindows(lcd, sx, sy, width, height);
+    LCD_WriteRAM_Prepare(lcd); // 准备写入GRAM
+    LCD_DC_HIGH(lcd);             // 设置为数据模式
+    LCD_FillStream(lcd, total, color);
+    LCD_PROF_LEAVE(lcd);
+}
 
-    // 计算单次发送的像素数量
-    batch_size = LCD_BATCH_BUFFER_SIZE / 2; // 每个像素2字节
+#define LCD_RECT_CHUNK 64 // 每次排序合并的矩形数
+
+/**
+ * @brief 比较两个矩形的排序先后
+ * @param a 矩形a
+ * @param ca 矩形a的颜色
+ * @param b 矩形b
+ * @param cb 矩形b的颜色
+ * @param vert 1:按(颜色,x,w,y)排序，便于上下合并 0:按(颜色,y,h,x)排序，便于左右合并
+ * @return a应排在b之后时返回1
+ */
+static u8 LCD_RectAfter(const lcd_rect_t *a, u16 ca, const lcd_rect_t *b, u16 cb, u8 vert)
+{
+    u32 ka, kb;
+
+    if (ca != cb)
+        return ca > cb;
+    ka = vert ? ((u32)a->x << 16 | a->w) : ((u32)a->y << 16 | a->h);
+    kb = vert ? ((u32)b->x << 16 | b->w) : ((u32)b->y << 16 | b->h);
+    if (ka != kb)
+        return ka > kb;
+    return vert ? a->y > b->y : a->x > b->x;
+}
+
+/**
+ * @brief 排序并合并相邻的同色矩形
+ * @param r 矩形表(就地修改)
+ * @param c 各矩形颜色(随矩形一起交换)
+ * @param n 矩形数
+ * @param vert 1:合并上下相邻 0:合并左右相邻
+ * @return 合并后的矩形数
+ *
+ * 功能说明：矩形数不超过LCD_RECT_CHUNK，使用插入排序；排序后可合并的矩形相邻，一趟扫描完成合并
+ */
+static u16 LCD_RectMerge(lcd_rect_t *r, u16 *c, u16 n, u8 vert)
+{
+    lcd_rect_t t;
+    u16 tc, i, j, m;
 
-    // 预填充数据缓冲区
-    for (i = 0; i < batch_size && i < LCD_BATCH_BUFFER_SIZE / 2; i++)
+    for (i = 1; i < n; i++)
     {
-        batch_buffer[i * 2] = color >> 8;       // 高字节
-        batch_buffer[i * 2 + 1] = color & 0xFF; // 低字节
+        t = r[i];
+        tc = c[i];
+        for (j = i; j > 0 && LCD_RectAfter(&r[j - 1], c[j - 1], &t, tc, vert); j--)
+        {
+            r[j] = r[j - 1];
+            c[j] = c[j - 1];
+        }
+        r[j] = t;
+        c[j] = tc;
     }
 
-    // 分批次发送数据
-    for (i = 0; i < total; i += batch_size)
+    m = 0;
+    for (i = 1; i < n; i++)
     {
-        // 计算本批次要传输的实际像素数
-        u32 current_batch = (i + batch_size > total) ? (total - i) : batch_size;
+        if (c[i] == c[m] &&
+            (vert ? (r[i].x == r[m].x && r[i].w == r[m].w && r[i].y == r[m].y + r[m].h)
+                  : (r[i].y == r[m].y && r[i].h == r[m].h && r[i].x == r[m].x + r[m].w)))
+        {
+            if (vert)
+                r[m].h += r[i].h;
+            else
+                r[m].w += r[i].w;
+            continue;
+        }
+        m++;
+        r[m] = r[i];
+        c[m] = c[i];
+    }
+    return n ? m + 1 : 0;
+}
 
-        // 发送批量数据
-        rt_spi_send(lcd_dev, batch_buffer, current_batch * 2); // 每像素2字节
+/**
+ * @brief 批量填充矩形(公共实现)
+ * @param lcd LCD实例
+ * @param rects 矩形表
+ * @param colors 各矩形颜色，RT_NULL时统一使用color
+ * @param color 统一颜色
+ * @param n 矩形数
+ *
+ * 功能说明：
+ * 1. 每次取LCD_RECT_CHUNK个矩形到栈上，裁剪到屏幕并丢弃空矩形
+ * 2. 交替按上下、左右方向排序合并，直到数量不再减少
+ * 3. 合并后同色矩形排在一起，逐个调用LCDx_Fill时批量缓冲区无需重新填充
+ */
+static void LCD_FillRectList(lcd_st7789_t *lcd, const lcd_rect_t *rects, const u16 *colors, u16 color, u16 n)
+{
+    lcd_rect_t r[LCD_RECT_CHUNK];
+    u16 c[LCD_RECT_CHUNK];
+    u16 i, k, m;
+    u8 vert, idle;
+
+    LCD_PROF_ENTER(lcd, LCD_STAT_FILL_RECTS);
+    while (n)
+    {
+        m = 0;
+        for (i = 0; i < n && i < LCD_RECT_CHUNK; i++)
+        {
+            r[m] = rects[i];
+            c[m] = colors ? colors[i] : color;
+            if (r[m].x >= lcd->dev->width || r[m].y >= lcd->dev->height || r[m].w == 0 || r[m].h == 0)
+                continue;
+            if (r[m].w > lcd->dev->width - r[m].x)
+                r[m].w = lcd->dev->width - r[m].x;
+            if (r[m].h > lcd->dev->height - r[m].y)
+                r[m].h = lcd->dev->height - r[m].y;
+            m++;
+        }
+        rects += i;
+        if (colors)
+            colors += i;
+        n -= i;
+
+        // 连续两趟(上下、左右各一次)都没有合并时结束
+        vert = 1;
+        idle = 0;
+        while (m > 1 && idle < 2)
+        {
+            k = LCD_RectMerge(r, c, m, vert);
+            idle = (k == m) ? idle + 1 : 0;
+            m = k;
+            vert = !vert;
+        }
+
+        for (k = 0; k < m; k++)
+            LCDx_Fill(lcd, r[k].x, r[k].y, r[k].x + r[k].w - 1, r[k].y + r[k].h - 1, c[k]);
     }
+    LCD_PROF_LEAVE(lcd);
+}
+
+/**
+ * @brief 批量填充同色矩形
+ * @param lcd LCD实例
+ * @param rects 矩形表
+ * @param n 矩形数
+ * @param color 填充颜色
+ *
+ * 功能说明：
+ * 1. 先排序并合并上下或左右相邻的矩形，再逐个填充，窗口数尽量少
+ * 2. 批量缓冲区只在第一个矩形时填充，之后各矩形直接发送
+ * 3. 超出屏幕的部分自动裁剪，宽或高为0的矩形被忽略
+ */
+void LCDx_FillRects(lcd_st7789_t *lcd, const lcd_rect_t *rects, u16 n, u16 color)
+{
+    LCD_GateReady(lcd);
+    LCD_FillRectList(lcd, rects, RT_NULL, color, n);
+}
+
+/**
+ * @brief 批量填充各自颜色的矩形
+ * @param lcd LCD实例
+ * @param rects 矩形表
+ * @param colors 各矩形的颜色(与rects一一对应)
+ * @param n 矩形数
+ *
+ * 功能说明：
+ * 1. 按颜色分组排序，合并相邻的同色矩形后逐个填充，同色矩形连续发送时批量缓冲区无需重新填充
+ * 2. 填充顺序与表中顺序无关，不同颜色的矩形不应重叠
+ * 3. 超出屏幕的部分自动裁剪，宽或高为0的矩形被忽略
+ */
+void LCDx_FillRectsColor(lcd_st7789_t *lcd, const lcd_rect_t *rects, const u16 *colors, u16 n)
+{
+    LCD_GateReady(lcd);
+    LCD_FillRectList(lcd, rects, colors, 0, n);
 }
 
 /* 字体显示函数 */
 /**
  * @brief 显示单个字符
+ * @param lcd LCD实例
  * @param x X坐标
  * @param y Y坐标
  * @param chr 要显示的字符
@@ -509,7 +1368,7 @@ void LCD_Fill(u16 sx, u16 sy, u16 ex, u16 ey, u16 color)
  * 2. 获取字模数据
  * 3. 根据不同模式高效绘制
  */
-void LCD_ShowChar(uint16_t x, uint16_t y, char chr, uint8_t size, uint8_t mode, uint16_t color, uint16_t bg_color)
+void LCDx_ShowChar(lcd_st7789_t *lcd, uint16_t x, uint16_t y, char chr, uint8_t size, uint8_t mode, uint16_t color, uint16_t bg_color)
 {
 
     uint8_t temp;
@@ -520,11 +1379,11 @@ void LCD_ShowChar(uint16_t x, uint16_t y, char chr, uint8_t size, uint8_t mode,
     uint16_t char_width = size / 2;                // 字符宽度
     uint16_t char_height = size;                   // 字符高度
     uint16_t conv[char_width][char_height];        // 临时存储字符数据
+    LCD_GateReady(lcd);
     memset(conv, 0, sizeof(conv));                 // 清空临时存储区
-    memset(batch_buffer, 0, sizeof(batch_buffer)); // 清空临时存储区
 
     // 检查边界
-    if (x + char_width > lcddev.width || y + char_height > lcddev.height)
+    if (x + char_width > lcd->dev->width || y + char_height > lcd->dev->height)
     {
 
         return;
@@ -566,7 +1425,7 @@ void LCD_ShowChar(uint16_t x, uint16_t y, char chr, uint8_t size, uint8_t mode,
             temp <<= 1; /* 移位, 以便获取下一个位的状态 */
             y++;
 
-            if (y >= lcddev.height)
+            if (y >= lcd->dev->height)
                 return; /* 超区域了 */
 
             if ((y - y0) == size) /* 显示完一列了? */
@@ -574,7 +1433,7 @@ void LCD_ShowChar(uint16_t x, uint16_t y, char chr, uint8_t size, uint8_t mode,
                 y = y0; /* y坐标复位 */
                 x++;    /* x坐标递增 */
 
-                if (x >= lcddev.width)
+                if (x >= lcd->dev->width)
                 {
                     return; /* x坐标超区域了 */
                 }
@@ -584,13 +1443,15 @@ void LCD_ShowChar(uint16_t x, uint16_t y, char chr, uint8_t size, uint8_t mode,
         }
     }
 
+    LCD_PROF_ENTER(lcd, LCD_STAT_CHAR);
+
     // 非透明模式，可以直接设置窗口进行批量绘制
     if (mode == 0)
     {
         // 设置显示窗口
-        LCD_SetWindows(x0, y0, char_width, char_height);
-        LCD_WriteRAM_Prepare();
-        LCD_DC_SET;
+        LCD_SetWindows(lcd, x0, y0, char_width, char_height);
+        LCD_WriteRAM_Prepare(lcd);
+        LCD_DC_HIGH(lcd);
 
         uint16_t xs = 0, ys = 0; // 字符内部坐标
         uint32_t pixel_idx = 0;  // 批处理缓冲区索引
@@ -600,13 +1461,13 @@ void LCD_ShowChar(uint16_t x, uint16_t y, char chr, uint8_t size, uint8_t mode,
             for (int j = 0; j < char_width; j++)
             {
                 // 将颜色数据放入缓冲区
-                batch_buffer[pixel_idx++] = conv[j][i] >> 8;
-                batch_buffer[pixel_idx++] = conv[j][i] & 0xFF;
+                lcd->batch[pixel_idx++] = conv[j][i] >> 8;
+                lcd->batch[pixel_idx++] = conv[j][i] & 0xFF;
 
                 // 如果缓冲区满了，发送数据
                 if (pixel_idx >= LCD_BATCH_BUFFER_SIZE)
                 {
-                    rt_spi_send(lcd_dev, batch_buffer, pixel_idx);
+                    LCD_SpiSend(lcd, lcd->batch, pixel_idx);
                     pixel_idx = 0;
                 }
             }
@@ -615,7 +1476,7 @@ void LCD_ShowChar(uint16_t x, uint16_t y, char chr, uint8_t size, uint8_t mode,
         // 发送剩余数据
         if (pixel_idx > 0)
         {
-            rt_spi_send(lcd_dev, batch_buffer, pixel_idx);
+            LCD_SpiSend(lcd, lcd->batch, pixel_idx);
         }
     }
     else // 透明模式
@@ -631,7 +1492,7 @@ void LCD_ShowChar(uint16_t x, uint16_t y, char chr, uint8_t size, uint8_t mode,
             {
                 // 只绘制字体数据为1的点
                 if (temp & 0x80)
-                    LCD_DrawPoint(pos_x, pos_y + i, color);
+                    LCDx_DrawPoint(lcd, pos_x, pos_y + i, color);
                 temp <<= 1;
 
                 // 检查是否到达字符高度
@@ -640,10 +1501,12 @@ void LCD_ShowChar(uint16_t x, uint16_t y, char chr, uint8_t size, uint8_t mode,
             }
         }
     }
+    LCD_PROF_LEAVE(lcd);
 }
 
 /**
  * @brief 在LCD上显示字符串
+ * @param lcd LCD实例
  * @param x 起始X坐标(像素)
  * @param y 起始Y坐标(像素)
  * @param width 显示区域宽度(像素)
@@ -665,10 +1528,13 @@ void LCD_ShowChar(uint16_t x, uint16_t y, char chr, uint8_t size, uint8_t mode,
  * - 确保坐标和区域大小在屏幕范围内
  * - 背景色参数为新增功能，旧代码需要更新
  */
-void LCD_ShowString(u16 x, u16 y, u16 width, u16 height, u8 size, u8 *p, u16 color, uint16_t bg_color)
+void LCDx_ShowString(lcd_st7789_t *lcd, u16 x, u16 y, u16 width, u16 height, u8 size, u8 *p, u16 color, uint16_t bg_color)
 {
 
     u8 x0 = x;
+
+    LCD_GateReady(lcd);
+    LCD_PROF_ENTER(lcd, LCD_STAT_STRING);
     width += x;
     height += y;
     while ((*p <= '~') && (*p >= ' ')) // 判断是不是非法字符!
@@ -680,14 +1546,16 @@ void LCD_ShowString(u16 x, u16 y, u16 width, u16 height, u8 size, u8 *p, u16 col
         }
         if (y >= height)
             break; // 退出
-        LCD_ShowChar(x, y, *p, size, 0, color, bg_color);
+        LCDx_ShowChar(lcd, x, y, *p, size, 0, color, bg_color);
         x += size / 2;
         p++;
     }
+    LCD_PROF_LEAVE(lcd);
 }
 
 /**
  * @brief 显示数字
+ * @param lcd LCD实例
  * @param x X坐标
  * @param y Y坐标
  * @param num 要显示的数字
@@ -701,11 +1569,14 @@ void LCD_ShowString(u16 x, u16 y, u16 width, u16 height, u8 size, u8 *p, u16 col
  * 2. 自动处理前导零
  * 3. 可自定义文字和背景颜色
  */
-void LCD_ShowNum(u16 x, u16 y, u32 num, u8 len, u8 size, u16 color, uint16_t bg_color)
+void LCDx_ShowNum(lcd_st7789_t *lcd, u16 x, u16 y, u32 num, u8 len, u8 size, u16 color, uint16_t bg_color)
 {
 
     u8 t, temp;
     u8 enshow = 0;
+
+    LCD_GateReady(lcd);
+    LCD_PROF_ENTER(lcd, LCD_STAT_SHOWNUM);
     for (t = 0; t < len; t++)
     {
         temp = (num / LCD_Pow(10, len - t - 1)) % 10;
@@ -713,18 +1584,20 @@ void LCD_ShowNum(u16 x, u16 y, u32 num, u8 len, u8 size, u16 color, uint16_t bg_
         {
             if (temp == 0)
             {
-                LCD_ShowChar(x + (size / 2) * t, y, ' ', size, 0, color, bg_color);
+                LCDx_ShowChar(lcd, x + (size / 2) * t, y, ' ', size, 0, color, bg_color);
                 continue;
             }
             else
                 enshow = 1;
         }
-        LCD_ShowChar(x + (size / 2) * t, y, temp + '0', size, 0, color, bg_color);
+        LCDx_ShowChar(lcd, x + (size / 2) * t, y, temp + '0', size, 0, color, bg_color);
     }
+    LCD_PROF_LEAVE(lcd);
 }
 
 /**
  * @brief 显示数字(增强版)
+ * @param lcd LCD实例
  * @param x X坐标
  * @param y Y坐标
  * @param num 要显示的数字
@@ -738,11 +1611,14 @@ void LCD_ShowNum(u16 x, u16 y, u32 num, u8 len, u8 size, u16 color, uint16_t bg_
  * 2. 可控制前导零显示
  * 3. 调用字符显示函数实现
  */
-void LCD_ShowxNum(u16 x, u16 y, u32 num, u8 len, u8 size, u8 mode, u16 color, uint16_t bg_color)
+void LCDx_ShowxNum(lcd_st7789_t *lcd, u16 x, u16 y, u32 num, u8 len, u8 size, u8 mode, u16 color, uint16_t bg_color)
 {
 
     u8 t, temp;
     u8 enshow = 0;
+
+    LCD_GateReady(lcd);
+    LCD_PROF_ENTER(lcd, LCD_STAT_SHOWNUM);
     for (t = 0; t < len; t++)
     {
         temp = (num / LCD_Pow(10, len - t - 1)) % 10;
@@ -751,16 +1627,322 @@ void LCD_ShowxNum(u16 x, u16 y, u32 num, u8 len, u8 size, u8 mode, u16 color, ui
             if (temp == 0)
             {
                 if (mode & 0X80)
-                    LCD_ShowChar(x + (size / 2) * t, y, '0', size, mode & 0X01, color, bg_color);
+                    LCDx_ShowChar(lcd, x + (size / 2) * t, y, '0', size, mode & 0X01, color, bg_color);
                 else
-                    LCD_ShowChar(x + (size / 2) * t, y, ' ', size, mode & 0X01, color, BACK_COLOR);
+                    LCDx_ShowChar(lcd, x + (size / 2) * t, y, ' ', size, mode & 0X01, color, BACK_COLOR);
                 continue;
             }
             else
                 enshow = 1;
         }
-        LCD_ShowChar(x + (size / 2) * t, y, temp + '0', size, mode & 0X01, color, BACK_COLOR);
+        LCDx_ShowChar(lcd, x + (size / 2) * t, y, temp + '0', size, mode & 0X01, color, BACK_COLOR);
+    }
+    LCD_PROF_LEAVE(lcd);
+}
+
+/**
+ * @brief 初始化数字显示框
+ * @param f 数字显示框
+ * @param x 左上角X坐标
+ * @param y 左上角Y坐标
+ * @param len 位数(1~LCD_NUM_MAX_LEN)
+ * @param size 字体大小(12/16)
+ * @param zero_pad 1:高位补0 0:高位显示空格
+ * @param color 数字颜色
+ * @param bg_color 背景颜色
+ *
+ * 功能说明：只初始化状态，不绘制；首次LCDx_NumField_Show时绘制全部位
+ */
+void LCD_NumField_Init(lcd_num_field_t *f, u16 x, u16 y, u8 len, u8 size, u8 zero_pad, u16 color, u16 bg_color)
+{
+    f->x = x;
+    f->y = y;
+    f->len = (len > LCD_NUM_MAX_LEN) ? LCD_NUM_MAX_LEN : len;
+    f->size = size;
+    f->zero_pad = zero_pad;
+    f->color = color;
+    f->bg_color = bg_color;
+    f->value = 0;
+    LCD_NumField_Invalidate(f);
+}
+
+/**
+ * @brief 标记数字显示框需要整体重绘
+ * @param f 数字显示框
+ *
+ * 功能说明：清屏或该区域被其他内容覆盖后调用，下一次LCDx_NumField_Show绘制全部位
+ */
+void LCD_NumField_Invalidate(lcd_num_field_t *f)
+{
+    rt_memset(f->shown, 0, sizeof(f->shown));
+}
+
+/**
+ * @brief 把一行字符展开后一次发送
+ * @param lcd LCD实例
+ * @param x 左上角X坐标
+ * @param y 左上角Y坐标
+ * @param text 字符(须为' '~'~')
+ * @param count 字符数(整行不超过批量缓冲区)
+ * @param size 字体大小(12/16)
+ * @param color 字符颜色
+ * @param bg_color 背景颜色
+ *
+ * 功能说明：字模每列2字节(高位在上)，逐行展开为RGB565写入批量缓冲区，整行只设置一次窗口
+ */
+static void LCD_SendGlyphRun(lcd_st7789_t *lcd, u16 x, u16 y, const char *text, u8 count, u8 size, u16 color, u16 bg_color)
+{
+    u16 *wire = (u16 *)lcd->batch;
+    u16 fg = LCD_TO_WIRE16(color);
+    u16 bg = LCD_TO_WIRE16(bg_color);
+    u8 cw = size / 2;
+    const u8 *font;
+    u32 n = 0;
+    u8 row, i, col, mask;
+
+    LCD_SetWindows(lcd, x, y, cw * count, size);
+    LCD_WriteRAM_Prepare(lcd);
+    LCD_DC_HIGH(lcd);
+
+    for (row = 0; row < size; row++)
+    {
+        mask = 0x80 >> (row % 8);
+        for (i = 0; i < count; i++)
+        {
+            font = (size == 12) ? asc2_1206[text[i] - ' '] : asc2_1608[text[i] - ' '];
+            for (col = 0; col < cw; col++)
+                wire[n++] = (font[col * 2 + row / 8] & mask) ? fg : bg;
+        }
+    }
+    LCD_SpiSend(lcd, lcd->batch, n * 2);
+}
+
+/**
+ * @brief 更新数字显示框
+ * @param lcd LCD实例
+ * @param f 数字显示框
+ * @param value 要显示的数值(超出位数时只显示低位)
+ *
+ * 功能说明：
+ * 1. 数值与上次相同且已绘制时直接返回
+ * 2. 从低位起逐位除以10，一次遍历得到各位字符，不再对每位调用LCD_Pow；超出位数时与LCD_ShowNum一样只显示低位
+ * 3. 只发送与屏幕上不同的位，相邻的变化位合并为一个窗口
+ * 4. 显示框超出屏幕或字体大小不是12/16时不绘制
+ */
+void LCDx_NumField_Show(lcd_st7789_t *lcd, lcd_num_field_t *f, u32 value)
+{
+    char text[LCD_NUM_MAX_LEN];
+    u32 v = value;
+    u8 i, run;
+
+    LCD_GateReady(lcd);
+    if (f->len == 0 || (f->size != 12 && f->size != 16) ||
+        f->x + (f->size / 2) * f->len > lcd->dev->width || f->y + f->size > lcd->dev->height)
+        return;
+    if (value == f->value && f->shown[0] != 0)
+        return;
+
+    i = f->len;
+    while (i--)
+    {
+        text[i] = '0' + v % 10;
+        v /= 10;
+    }
+    for (i = 0; !f->zero_pad && i < f->len - 1 && text[i] == '0'; i++)
+        text[i] = ' ';
+
+    LCD_PROF_ENTER(lcd, LCD_STAT_SHOWNUM);
+    for (i = 0; i < f->len; i += run)
+    {
+        for (run = 0; i + run < f->len && text[i + run] != f->shown[i + run]; run++)
+            f->shown[i + run] = text[i + run];
+        if (run)
+            LCD_SendGlyphRun(lcd, f->x + i * (f->size / 2), f->y, text + i, run, f->size, f->color, f->bg_color);
+        else
+            run = 1;
+    }
+    f->value = value;
+    LCD_PROF_LEAVE(lcd);
+}
+
+/**
+ * @brief 初始化文本框
+ * @param box 文本框
+ * @param width 区域宽度
+ * @param height 区域高度
+ * @param align 对齐方式(LCD_ALIGN_LEFT/CENTER/RIGHT)
+ * @param color 文字颜色
+ * @param bg_color 背景颜色
+ *
+ * 功能说明：只初始化状态，不绘制
+ */
+void LCD_TextBox_Init(lcd_text_box_t *box, u16 width, u16 height, u8 align, u16 color, u16 bg_color)
+{
+    box->width = width;
+    box->height = height;
+    box->align = align;
+    box->color = color;
+    box->bg_color = bg_color;
+    LCD_TextBox_Invalidate(box);
+}
+
+/**
+ * @brief 忘记文本框上次绘制的内容
+ * @param box 文本框
+ *
+ * 功能说明：清屏或区域被其他内容覆盖后调用，下一次LCDx_Printf不再擦除旧文字
+ */
+void LCD_TextBox_Invalidate(lcd_text_box_t *box)
+{
+    box->lines = 0;
+}
+
+/**
+ * @brief 格式化并在文本框内排版显示(公共实现)
+ * @param lcd LCD实例
+ * @param x 文本框左上角X坐标
+ * @param y 文本框左上角Y坐标
+ * @param box 文本框
+ * @param size 字体大小(12/16)
+ * @param fmt 格式字符串
+ * @param args 参数列表
+ * @return 显示的行数
+ *
+ * 功能说明：
+ * 1. 格式化到LCD_PRINTF_BUF_SIZE字节的栈上缓冲区，'\t'按空格、其他不可显示字符按'?'处理
+ * 2. 按字符宽度测量，在空格处折行，单词长于一行时强制断开；'\n'强制换行；超出文本框高度的行被丢弃
+ * 3. 每行按对齐方式定位，整行只设置一次窗口
+ * 4. 同一位置、同一字体再次调用时，每行只擦除旧文字超出新文字的左右两段；位置或字体改变时先整体擦除旧文字
+ */
+static int LCD_VPrintf(lcd_st7789_t *lcd, u16 x, u16 y, lcd_text_box_t *box, u8 size, const char *fmt, va_list args)
+{
+    char buf[LCD_PRINTF_BUF_SIZE];
+    u16 start[LCD_TEXT_MAX_LINES];
+    u8 len[LCD_TEXT_MAX_LINES];
+    u16 n1, n2, p1, p2, band, room;
+    u16 cw = size / 2;
+    u16 max_chars, max_lines, pos, n;
+    int brk;
+    u8 i, lines, total;
+
+    if ((size != 12 && size != 16) || x >= lcd->dev->width || y >= lcd->dev->height)
+        return 0;
+    rt_vsnprintf(buf, sizeof(buf), fmt, args);
+    for (pos = 0; buf[pos]; pos++)
+    {
+        if (buf[pos] == '\t')
+            buf[pos] = ' ';
+        else if ((buf[pos] < ' ' || buf[pos] > '~') && buf[pos] != '\n')
+            buf[pos] = '?';
+    }
+
+    room = (box->width < lcd->dev->width - x) ? box->width : lcd->dev->width - x;
+    max_chars = room / cw;
+    max_lines = ((box->height < lcd->dev->height - y) ? box->height : lcd->dev->height - y) / size;
+    if (max_chars > 255)
+        max_chars = 255;
+    if (max_lines > LCD_TEXT_MAX_LINES)
+        max_lines = LCD_TEXT_MAX_LINES;
+
+    // 折行：记录各行在buf中的起点和长度
+    lines = 0;
+    pos = 0;
+    while (max_chars && buf[pos] && lines < max_lines)
+    {
+        brk = -1;
+        for (n = 0; buf[pos + n] && buf[pos + n] != '\n' && n < max_chars; n++)
+        {
+            if (buf[pos + n] == ' ')
+                brk = n;
+        }
+        start[lines] = pos;
+        if (buf[pos + n] && buf[pos + n] != '\n' && buf[pos + n] != ' ' && brk > 0)
+            n = brk; // 行满且下一个字符仍属于当前单词，退回到最后一个空格
+        pos += n;
+        while (n && buf[start[lines] + n - 1] == ' ')
+            n--;
+        len[lines++] = n;
+
+        if (buf[pos] == '\n')
+            pos++;
+        else
+            while (buf[pos] == ' ')
+                pos++;
+    }
+
+    LCD_PROF_ENTER(lcd, LCD_STAT_STRING);
+
+    // 位置或字体改变，旧文字的行与新文字不对齐，先整体擦除
+    if (box->lines && (box->x != x || box->y != y || box->size != size))
+    {
+        for (i = 0; i < box->lines; i++)
+        {
+            if (box->span[i][1] > box->span[i][0])
+                LCDx_Fill(lcd, box->x + box->span[i][0], box->y + i * box->size,
+                          box->x + box->span[i][1] - 1, box->y + (i + 1) * box->size - 1, box->bg_color);
+        }
+        box->lines = 0;
+    }
+
+    total = (lines > box->lines) ? lines : box->lines;
+    for (i = 0; i < total; i++)
+    {
+        band = y + i * size;
+        n1 = n2 = 0;
+        if (i < lines && len[i])
+        {
+            if (box->align == LCD_ALIGN_CENTER)
+                n1 = (room - len[i] * cw) / 2;
+            else if (box->align == LCD_ALIGN_RIGHT)
+                n1 = room - len[i] * cw;
+            n2 = n1 + len[i] * cw;
+            LCD_SendGlyphRun(lcd, x + n1, band, buf + start[i], len[i], size, box->color, box->bg_color);
+        }
+
+        // 擦除旧文字在新文字左右两侧露出的部分(新行为空时n1 = n2 = 0，整段擦除)
+        p1 = (i < box->lines) ? box->span[i][0] : 0;
+        p2 = (i < box->lines) ? box->span[i][1] : 0;
+        if (p1 < p2 && p1 < n1)
+            LCDx_Fill(lcd, x + p1, band, x + ((p2 < n1) ? p2 : n1) - 1, band + size - 1, box->bg_color);
+        if (p1 < p2 && p2 > n2)
+            LCDx_Fill(lcd, x + ((p1 > n2) ? p1 : n2), band, x + p2 - 1, band + size - 1, box->bg_color);
+
+        box->span[i][0] = n1;
+        box->span[i][1] = n2;
     }
+
+    box->x = x;
+    box->y = y;
+    box->size = size;
+    box->lines = lines;
+    LCD_PROF_LEAVE(lcd);
+    return lines;
+}
+
+/**
+ * @brief 格式化并在文本框内排版显示
+ * @param lcd LCD实例
+ * @param x 文本框左上角X坐标
+ * @param y 文本框左上角Y坐标
+ * @param box 文本框(尺寸、对齐、颜色及上次绘制的范围)
+ * @param size 字体大小(12/16)
+ * @param fmt 格式字符串(同rt_kprintf)
+ * @return 显示的行数
+ *
+ * 功能说明：
+ * 1. 按单词折行并按box->align对齐，每行一次窗口
+ * 2. 只擦除上次文字中未被新文字覆盖的部分，不填充整个文本框
+ */
+int LCDx_Printf(lcd_st7789_t *lcd, u16 x, u16 y, lcd_text_box_t *box, u8 size, const char *fmt, ...)
+{
+    va_list args;
+    int lines;
+
+    LCD_GateReady(lcd);
+    va_start(args, fmt);
+    lines = LCD_VPrintf(lcd, x, y, box, size, fmt, args);
+    va_end(args);
+    return lines;
 }
 
 /**
@@ -783,6 +1965,7 @@ u32 LCD_Pow(u8 m, u8 n)
 
 /**
  * @brief 显示图片
+ * @param lcd LCD实例
  * @param x X坐标
  * @param y Y坐标
  * @param width 图片宽度
@@ -795,17 +1978,33 @@ u32 LCD_Pow(u8 m, u8 n)
  * 3. 支持RGB565格式图片
  * 4. 使用优化的批量传输方式
  */
-void LCD_ShowImage(u16 x, u16 y, u16 width, u16 height, const u16 *p)
+void LCDx_ShowImage(lcd_st7789_t *lcd, u16 x, u16 y, u16 width, u16 height, const u16 *p)
 {
     u32 i, j;
     u32 total = width * height;
     u32 batch_size = LCD_BATCH_BUFFER_SIZE / 2; // 每批次处理的像素数量(2字节/像素)
     u32 current_batch;
 
+    LCD_GateReady(lcd);
+    LCD_PROF_ENTER(lcd, LCD_STAT_IMAGE);
+
+    // 大图使用12位格式传输
+    if (LCD_Use444(lcd, total))
+    {
+        LCD_SetColmod(lcd, LCD_PIXFMT_RGB444);
+        LCD_SetWindows(lcd, x, y, width, height);
+        LCD_WriteRAM_Prepare(lcd);
+        LCD_DC_HIGH(lcd);
+        LCD_Flush444(lcd, p, total);
+        LCD_SetColmod(lcd, LCD_PIXFMT_RGB565);
+        LCD_PROF_LEAVE(lcd);
+        return;
+    }
+
     // 设置窗口
-    LCD_SetWindows(x, y, width, height);
-    LCD_WriteRAM_Prepare(); // 开始写入GRAM
-    LCD_DC_SET;             // 设置为数据模式
+    LCD_SetWindows(lcd, x, y, width, height);
+    LCD_WriteRAM_Prepare(lcd); // 开始写入GRAM
+    LCD_DC_HIGH(lcd);             // 设置为数据模式
 
     // 分批次发送数据
     for (i = 0; i < total; i += batch_size)
@@ -817,49 +2016,431 @@ void LCD_ShowImage(u16 x, u16 y, u16 width, u16 height, const u16 *p)
         for (j = 0; j < current_batch; j++)
         {
             u16 color = p[i + j];
-            batch_buffer[j * 2] = color >> 8;       // 高字节
-            batch_buffer[j * 2 + 1] = color & 0xFF; // 低字节
+            lcd->batch[j * 2] = color >> 8;       // 高字节
+            lcd->batch[j * 2 + 1] = color & 0xFF; // 低字节
         }
 
         // 发送批量数据
-        rt_spi_send(lcd_dev, batch_buffer, current_batch * 2); // 每像素2字节
+        LCD_SpiSend(lcd, lcd->batch, current_batch * 2); // 每像素2字节
     }
+    LCD_PROF_LEAVE(lcd);
 }
 
 /**
- * @brief 画线函数
- * @param x1 起点X坐标
- * @param y1 起点Y坐标
- * @param x2 终点X坐标
- * @param y2 终点Y坐标
- * @param color 线条颜色
+ * @brief 按行发送跨距存放的RGB565像素
+ * @param lcd LCD实例(窗口已设置并处于数据模式)
+ * @param src 首行首像素
+ * @param stride 源数据每行像素数
+ * @param width 每行像素数
+ * @param height 行数
  *
- * 功能说明：
- * 1. 使用Bresenham算法
- * 2. 支持任意方向直线
- * 3. 收集所有点后一次批量绘制
+ * 功能说明：逐行转换为发送字节序写入批量缓冲区，一行可跨批次，缓冲区满即发送
  */
-void LCD_DrawLine(u16 x1, u16 y1, u16 x2, u16 y2, u16 color)
+static void LCD_StreamRect(lcd_st7789_t *lcd, const u16 *src, u16 stride, u16 width, u16 height)
 {
+    u16 *wire = (u16 *)lcd->batch;
+    u32 batch_size = LCD_BATCH_BUFFER_SIZE / 2; // 每批次像素数
+    u32 n = 0, left, c;
+    const u16 *row;
+    u16 r, color;
 
-    int xerr = 0, yerr = 0, distance;
-    int incx, incy, row, col;
-    u16 points_x[512]; // 点坐标缓冲区
-    u16 points_y[512];
-    u16 point_count = 0;
-
-    // 特殊情况处理 - 水平或垂直线可直接使用Fill函数
-    if (x1 == x2)
-    { // 垂直线
-        // 确保y1 <= y2
-        if (y1 > y2)
+    for (r = 0; r < height; r++, src += stride)
+    {
+        row = src;
+        left = width;
+        while (left)
         {
-            u16 temp = y1;
-            y1 = y2;
-            y2 = temp;
+            c = (left < batch_size - n) ? left : batch_size - n;
+            left -= c;
+            while (c--)
+            {
+                color = *row++;
+                wire[n++] = LCD_TO_WIRE16(color);
+            }
+            if (n == batch_size)
+            {
+                LCD_SpiSend(lcd, lcd->batch, n * 2);
+                n = 0;
+            }
+        }
+    }
+    if (n)
+        LCD_SpiSend(lcd, lcd->batch, n * 2);
+}
+
+/**
+ * @brief 从大图(图集)中取子区域显示
+ * @param lcd LCD实例
+ * @param x 显示位置X坐标
+ * @param y 显示位置Y坐标
+ * @param src 源图首地址(RGB565，行优先)
+ * @param stride 源图每行像素数
+ * @param sx 子区域在源图中的X坐标
+ * @param sy 子区域在源图中的Y坐标
+ * @param width 子区域宽度
+ * @param height 子区域高度
+ *
+ * 功能说明：
+ * 1. 整个子区域只设置一次窗口，逐行从源图读取直接写入批量缓冲区，不需要临时内存
+ * 2. 一行可跨批次，缓冲区满即发送，批次大小与行宽无关
+ * 3. 超出屏幕右侧/下方的部分自动裁剪
+ * 4. RGB444模式下宽度为偶数时逐行打包为12位发送
+ */
+void LCDx_BlitImage(lcd_st7789_t *lcd, u16 x, u16 y, const u16 *src, u16 stride, u16 sx, u16 sy, u16 width, u16 height)
+{
+    u32 n = 0;
+    u16 r;
+
+    LCD_GateReady(lcd);
+    if (x >= lcd->dev->width || y >= lcd->dev->height || width == 0 || height == 0)
+        return;
+    if (width > lcd->dev->width - x)
+        width = lcd->dev->width - x;
+    if (height > lcd->dev->height - y)
+        height = lcd->dev->height - y;
+
+    LCD_PROF_ENTER(lcd, LCD_STAT_BLIT);
+
+    src += (u32)sy * stride + sx;
+
+    // 大图且宽度为偶数时逐行打包为12位，每行3*width/2字节
+    if (LCD_Use444(lcd, (u32)width * height) && (width & 1) == 0)
+    {
+        u32 row_bytes = (u32)width / 2 * 3;
+
+        LCD_SetColmod(lcd, LCD_PIXFMT_RGB444);
+        LCD_SetWindows(lcd, x, y, width, height);
+        LCD_WriteRAM_Prepare(lcd);
+        LCD_DC_HIGH(lcd);
+        for (r = 0; r < height; r++, src += stride)
+        {
+            if (n + row_bytes > LCD_BATCH_BUFFER_SIZE)
+            {
+                LCD_SpiSend(lcd, lcd->batch, n);
+                n = 0;
+            }
+            n += LCD_Pack444(lcd->batch + n, src, width);
+        }
+        LCD_SpiSend(lcd, lcd->batch, n);
+        LCD_SetColmod(lcd, LCD_PIXFMT_RGB565);
+        LCD_PROF_LEAVE(lcd);
+        return;
+    }
+
+    LCD_SetWindows(lcd, x, y, width, height);
+    LCD_WriteRAM_Prepare(lcd);
+    LCD_DC_HIGH(lcd);
+    LCD_StreamRect(lcd, src, stride, width, height);
+    LCD_PROF_LEAVE(lcd);
+}
+
+/**
+ * @brief 计算源图像素变换后的位置
+ * @param mode 变换(LCD_ROTATE_xxx | LCD_MIRROR_xxx)
+ * @param w 源图宽度
+ * @param h 源图高度
+ * @param u 源图X坐标
+ * @param v 源图Y坐标
+ * @param dx 返回变换后X坐标
+ * @param dy 返回变换后Y坐标
+ *
+ * 功能说明：先镜像再顺时针旋转；坐标可超出图片，用于求线性步进
+ */
+static void LCD_RotMap(u8 mode, rt_int32_t w, rt_int32_t h, rt_int32_t u, rt_int32_t v, rt_int32_t *dx, rt_int32_t *dy)
+{
+    if (mode & LCD_MIRROR_H)
+        u = w - 1 - u;
+    if (mode & LCD_MIRROR_V)
+        v = h - 1 - v;
+
+    switch (mode & 0x03)
+    {
+    case LCD_ROTATE_90:
+        *dx = h - 1 - v;
+        *dy = u;
+        break;
+    case LCD_ROTATE_180:
+        *dx = w - 1 - u;
+        *dy = h - 1 - v;
+        break;
+    case LCD_ROTATE_270:
+        *dx = v;
+        *dy = w - 1 - u;
+        break;
+    default:
+        *dx = u;
+        *dy = v;
+        break;
+    }
+}
+
+/**
+ * @brief 按MADCTL方向位把控制器地址换算为GRAM物理位置
+ * @param madctl MADCTL值(只用MY/MX/MV位)
+ * @param c 列地址
+ * @param r 行地址
+ * @param px 返回GRAM列
+ * @param py 返回GRAM行
+ *
+ * 功能说明：与LCDx_Scan_Dir的偏移换算一致，MV交换后列地址对应GRAM行，MX/MY在交换后镜像
+ */
+static void LCD_MadctlMap(u8 madctl, rt_int32_t c, rt_int32_t r, rt_int32_t *px, rt_int32_t *py)
+{
+    rt_int32_t col = (madctl & 0x20) ? r : c;
+    rt_int32_t row = (madctl & 0x20) ? c : r;
+
+    *px = (madctl & 0x40) ? LCD_GRAM_W - 1 - col : col;
+    *py = (madctl & 0x80) ? LCD_GRAM_H - 1 - row : row;
+}
+
+/**
+ * @brief 临时切换MADCTL，由控制器完成旋转
+ * @param lcd LCD实例
+ * @param x 目标区域左上角X坐标
+ * @param y 目标区域左上角Y坐标
+ * @param dw 目标区域宽度
+ * @param dh 目标区域高度
+ * @param src 源图子区域首像素
+ * @param stride 源图每行像素数
+ * @param sw 源图子区域宽度
+ * @param sh 源图子区域高度
+ * @param step 源图子区域(0,0)、X+1、Y+1三点在目标区域中的位置/步进{ox, oy, ux, uy, vx, vy}
+ *
+ * 功能说明：
+ * 1. 求出当前方向下三点的GRAM物理位置，在8种MADCTL方向中找出按源图行顺序写入恰好落在这些位置的一种
+ * 2. 切换方向并按新方向设置窗口，源图按行原样发送，完成后恢复原方向
+ * 3. MADCTL只影响MCU写入GRAM的地址顺序，不影响面板扫描，切换不会造成闪烁
+ */
+static void LCD_RotateMadctl(lcd_st7789_t *lcd, u16 x, u16 y, u16 dw, u16 dh, const u16 *src, u16 stride,
+                             u16 sw, u16 sh, const rt_int32_t *step)
+{
+    rt_int32_t p0x, p0y, pux, puy, pvx, pvy, q0x, q0y, qux, quy, qvx, qvy, col, row;
+    rt_int32_t lx = (rt_int32_t)x + step[0] + lcd->x_off;
+    rt_int32_t ly = (rt_int32_t)y + step[1] + lcd->y_off;
+    u8 madctl, m;
+
+    (void)dw; // 目标区域尺寸仅用于性能跟踪
+    (void)dh;
+
+    LCD_MadctlMap(lcd->madctl, lx, ly, &p0x, &p0y);
+    LCD_MadctlMap(lcd->madctl, lx + step[2], ly + step[3], &pux, &puy);
+    LCD_MadctlMap(lcd->madctl, lx + step[4], ly + step[5], &pvx, &pvy);
+
+    for (m = 0; m < 8; m++)
+    {
+        madctl = m << 5;
+        LCD_MadctlMap(madctl, 0, 0, &q0x, &q0y);
+        LCD_MadctlMap(madctl, 1, 0, &qux, &quy);
+        LCD_MadctlMap(madctl, 0, 1, &qvx, &qvy);
+        if (qux - q0x == pux - p0x && quy - q0y == puy - p0y && qvx - q0x == pvx - p0x && qvy - q0y == pvy - p0y)
+            break;
+    }
+
+    // 由GRAM位置反求新方向下的起始地址
+    col = (madctl & 0x40) ? LCD_GRAM_W - 1 - p0x : p0x;
+    row = (madctl & 0x80) ? LCD_GRAM_H - 1 - p0y : p0y;
+
+    LCD_PROF_WINDOW(lcd, x, y, dw, dh);
+    LCD_WriteReg(lcd, 0x36, madctl | (lcd->madctl & 0x1F));
+    LCD_WR_ADDR(lcd, lcd->dev->setxcmd, (madctl & 0x20) ? row : col, ((madctl & 0x20) ? row : col) + sw - 1);
+    LCD_WR_ADDR(lcd, lcd->dev->setycmd, (madctl & 0x20) ? col : row, ((madctl & 0x20) ? col : row) + sh - 1);
+    LCD_WriteRAM_Prepare(lcd);
+    LCD_DC_HIGH(lcd);
+    LCD_StreamRect(lcd, src, stride, sw, sh);
+    LCD_WriteReg(lcd, 0x36, lcd->madctl);
+}
+
+/**
+ * @brief 软件分块转置后发送
+ * @param lcd LCD实例
+ * @param x 目标区域左上角X坐标
+ * @param y 目标区域左上角Y坐标
+ * @param dw 目标区域宽度
+ * @param dh 目标区域高度
+ * @param src 源图子区域首像素
+ * @param stride 源图每行像素数
+ * @param sw 源图子区域宽度
+ * @param sh 源图子区域高度
+ * @param step 同LCD_RotateMadctl
+ *
+ * 功能说明：
+ * 1. 整个区域一次窗口，按批量缓冲区能容纳的目标行数分块
+ * 2. 每块按源图行顺序连续读取，按步进写到缓冲区中的目标位置，读取始终是顺序的，
+ *    旋转90/270度时每块即源图的一个竖条
+ */
+static void LCD_RotateSoft(lcd_st7789_t *lcd, u16 x, u16 y, u16 dw, u16 dh, const u16 *src, u16 stride,
+                           u16 sw, u16 sh, const rt_int32_t *step)
+{
+    u16 *wire = (u16 *)lcd->batch;
+    u16 band = (LCD_BATCH_BUFFER_SIZE / 2) / dw; // 每块目标行数
+    rt_int32_t step_u = step[3] * dw + step[2];  // 源图X+1时缓冲区位置的增量
+    rt_int32_t off, i, j, i0, i1, j0, j1, t;
+    const u16 *s;
+    u16 d0, rows, color;
+
+    LCD_SetWindows(lcd, x, y, dw, dh);
+    LCD_WriteRAM_Prepare(lcd);
+    LCD_DC_HIGH(lcd);
+
+    for (d0 = 0; d0 < dh; d0 += rows)
+    {
+        rows = (dh - d0 > band) ? band : dh - d0;
+
+        // 本块目标行对应的源图范围：旋转90/270度时为若干列，否则为若干行
+        i0 = 0;
+        i1 = sw - 1;
+        j0 = 0;
+        j1 = sh - 1;
+        if (step[3] != 0)
+        {
+            i0 = (d0 - step[1]) * step[3];
+            i1 = (d0 + rows - 1 - step[1]) * step[3];
+        }
+        else
+        {
+            j0 = (d0 - step[1]) * step[5];
+            j1 = (d0 + rows - 1 - step[1]) * step[5];
+        }
+        if (i0 > i1)
+        {
+            t = i0;
+            i0 = i1;
+            i1 = t;
+        }
+        if (j0 > j1)
+        {
+            t = j0;
+            j0 = j1;
+            j1 = t;
+        }
+
+        for (j = j0; j <= j1; j++)
+        {
+            s = src + j * stride + i0;
+            off = (step[1] + i0 * step[3] + j * step[5] - d0) * dw + step[0] + i0 * step[2] + j * step[4];
+            for (i = i0; i <= i1; i++, off += step_u)
+            {
+                color = *s++;
+                wire[off] = LCD_TO_WIRE16(color);
+            }
         }
-        LCD_Fill(x1, y1, x1, y2, color);
+        LCD_SpiSend(lcd, lcd->batch, (u32)rows * dw * 2);
+    }
+}
+
+/**
+ * @brief 旋转/镜像显示图片
+ * @param lcd LCD实例
+ * @param x 显示区域左上角X坐标
+ * @param y 显示区域左上角Y坐标
+ * @param width 源图宽度
+ * @param height 源图高度
+ * @param p 源图数据(RGB565，行优先)
+ * @param mode 变换：LCD_ROTATE_0/90/180/270(顺时针) | LCD_MIRROR_H/LCD_MIRROR_V(先于旋转)，
+ *             加LCD_ROTATE_SOFT强制使用软件转置
+ *
+ * 功能说明：
+ * 1. 旋转90/270度时显示区域为height x width，超出屏幕右侧/下方的部分自动裁剪
+ * 2. 默认只对这一个窗口临时切换MADCTL，由控制器完成旋转，CPU开销与LCD_ShowImage相同，
+ *    只多两次MADCTL写入(4字节)；不改变全局显示方向
+ * 3. LCD_ROTATE_SOFT时在批量缓冲区中分块转置，不依赖控制器地址映射
+ * 4. 始终以RGB565发送，不受LCD_SetBulkFormat影响
+ */
+void LCDx_ShowImageRotate(lcd_st7789_t *lcd, u16 x, u16 y, u16 width, u16 height, const u16 *p, u8 mode)
+{
+    rt_int32_t step[6], ax, ay, bx, by, u0, v0, u1, v1;
+    u16 dw, dh;
+
+    LCD_GateReady(lcd);
+    if (x >= lcd->dev->width || y >= lcd->dev->height || width == 0 || height == 0)
+        return;
+
+    dw = (mode & 0x01) ? height : width;
+    dh = (mode & 0x01) ? width : height;
+    if (dw > lcd->dev->width - x)
+        dw = lcd->dev->width - x;
+    if (dh > lcd->dev->height - y)
+        dh = lcd->dev->height - y;
+
+    // 变换是线性的，由源图(0,0)、(1,0)、(0,1)三点求出步进
+    LCD_RotMap(mode, width, height, 0, 0, &step[0], &step[1]);
+    LCD_RotMap(mode, width, height, 1, 0, &ax, &ay);
+    LCD_RotMap(mode, width, height, 0, 1, &bx, &by);
+    step[2] = ax - step[0];
+    step[3] = ay - step[1];
+    step[4] = bx - step[0];
+    step[5] = by - step[1];
+
+    // 可见区域两个对角反求源图子区域
+    if (step[2] != 0)
+    {
+        ax = -step[0] * step[2];
+        ay = -step[1] * step[5];
+        bx = (dw - 1 - step[0]) * step[2];
+        by = (dh - 1 - step[1]) * step[5];
+    }
+    else
+    {
+        ax = -step[1] * step[3];
+        ay = -step[0] * step[4];
+        bx = (dh - 1 - step[1]) * step[3];
+        by = (dw - 1 - step[0]) * step[4];
+    }
+    u0 = (ax < bx) ? ax : bx;
+    u1 = (ax < bx) ? bx : ax;
+    v0 = (ay < by) ? ay : by;
+    v1 = (ay < by) ? by : ay;
+
+    // 换算为源图子区域左上角的位置
+    LCD_RotMap(mode, width, height, u0, v0, &step[0], &step[1]);
+    p += (u32)v0 * width + u0;
+
+    LCD_PROF_ENTER(lcd, LCD_STAT_ROTATE);
+    if (mode & LCD_ROTATE_SOFT)
+        LCD_RotateSoft(lcd, x, y, dw, dh, p, width, u1 - u0 + 1, v1 - v0 + 1, step);
+    else
+        LCD_RotateMadctl(lcd, x, y, dw, dh, p, width, u1 - u0 + 1, v1 - v0 + 1, step);
+    LCD_PROF_LEAVE(lcd);
+}
+
+/**
+ * @brief 画线函数
+ * @param lcd LCD实例
+ * @param x1 起点X坐标
+ * @param y1 起点Y坐标
+ * @param x2 终点X坐标
+ * @param y2 终点Y坐标
+ * @param color 线条颜色
+ *
+ * 功能说明：
+ * 1. 使用Bresenham算法
+ * 2. 支持任意方向直线
+ * 3. 收集所有点后一次批量绘制
+ */
+void LCDx_DrawLine(lcd_st7789_t *lcd, u16 x1, u16 y1, u16 x2, u16 y2, u16 color)
+{
+
+    int xerr = 0, yerr = 0, distance;
+    int incx, incy, row, col;
+    u16 points_x[512]; // 点坐标缓冲区
+    u16 points_y[512];
+    u16 point_count = 0;
 
+    LCD_GateReady(lcd);
+    LCD_PROF_ENTER(lcd, LCD_STAT_LINE);
+
+    // 特殊情况处理 - 水平或垂直线可直接使用Fill函数
+    if (x1 == x2)
+    { // 垂直线
+        // 确保y1 <= y2
+        if (y1 > y2)
+        {
+            u16 temp = y1;
+            y1 = y2;
+            y2 = temp;
+        }
+        LCDx_Fill(lcd, x1, y1, x1, y2, color);
+        LCD_PROF_LEAVE(lcd);
         return;
     }
 
@@ -872,8 +2453,8 @@ void LCD_DrawLine(u16 x1, u16 y1, u16 x2, u16 y2, u16 color)
             x1 = x2;
             x2 = temp;
         }
-        LCD_Fill(x1, y1, x2, y1, color);
-
+        LCDx_Fill(lcd, x1, y1, x2, y1, color);
+        LCD_PROF_LEAVE(lcd);
         return;
     }
 
@@ -940,8 +2521,8 @@ void LCD_DrawLine(u16 x1, u16 y1, u16 x2, u16 y2, u16 color)
     // 如果线段较短（少于30个点），或者点极为分散，直接使用DrawPoints批量绘制
     if (point_count < 30 || (max_x - min_x > 100) || (max_y - min_y > 100))
     {
-        LCD_DrawPoints(points_x, points_y, point_count, color);
-
+        LCDx_DrawPoints(lcd, points_x, points_y, point_count, color);
+        LCD_PROF_LEAVE(lcd);
         return;
     }
 
@@ -959,7 +2540,7 @@ void LCD_DrawLine(u16 x1, u16 y1, u16 x2, u16 y2, u16 color)
             if (horizontal_len > 3)
             {
                 // 使用Fill绘制水平线段
-                LCD_Fill(points_x[start_x], current_y,
+                LCDx_Fill(lcd, points_x[start_x], current_y,
                          points_x[start_x + horizontal_len - 1], current_y, color);
                 processed += horizontal_len;
             }
@@ -968,7 +2549,7 @@ void LCD_DrawLine(u16 x1, u16 y1, u16 x2, u16 y2, u16 color)
                 // 短线段，暂存
                 for (u16 j = 0; j < horizontal_len; j++)
                 {
-                    LCD_DrawPoint(points_x[start_x + j], current_y, color);
+                    LCDx_DrawPoint(lcd, points_x[start_x + j], current_y, color);
                 }
                 processed += horizontal_len;
             }
@@ -983,7 +2564,7 @@ void LCD_DrawLine(u16 x1, u16 y1, u16 x2, u16 y2, u16 color)
     // 处理最后一个线段
     if (horizontal_len > 3)
     {
-        LCD_Fill(points_x[start_x], current_y,
+        LCDx_Fill(lcd, points_x[start_x], current_y,
                  points_x[start_x + horizontal_len - 1], current_y, color);
         processed += horizontal_len;
     }
@@ -991,7 +2572,7 @@ void LCD_DrawLine(u16 x1, u16 y1, u16 x2, u16 y2, u16 color)
     {
         for (u16 j = 0; j < horizontal_len; j++)
         {
-            LCD_DrawPoint(points_x[start_x + j], current_y, color);
+            LCDx_DrawPoint(lcd, points_x[start_x + j], current_y, color);
         }
         processed += horizontal_len;
     }
@@ -1020,13 +2601,15 @@ void LCD_DrawLine(u16 x1, u16 y1, u16 x2, u16 y2, u16 color)
         // 批量绘制剩余点
         if (count > 0)
         {
-            LCD_DrawPoints(remaining_x, remaining_y, count, color);
+            LCDx_DrawPoints(lcd, remaining_x, remaining_y, count, color);
         }
     }
+    LCD_PROF_LEAVE(lcd);
 }
 
 /**
  * @brief 画矩形
+ * @param lcd LCD实例
  * @param x1 左上角X坐标
  * @param y1 左上角Y坐标
  * @param x2 右下角X坐标
@@ -1037,17 +2620,21 @@ void LCD_DrawLine(u16 x1, u16 y1, u16 x2, u16 y2, u16 color)
  * 1. 调用画线函数实现
  * 2. 绘制四条边组成矩形
  */
-void LCD_DrawRectangle(u16 x1, u16 y1, u16 x2, u16 y2, u16 color)
+void LCDx_DrawRectangle(lcd_st7789_t *lcd, u16 x1, u16 y1, u16 x2, u16 y2, u16 color)
 {
 
-    LCD_DrawLine(x1, y1, x2, y1, color);
-    LCD_DrawLine(x1, y1, x1, y2, color);
-    LCD_DrawLine(x1, y2, x2, y2, color);
-    LCD_DrawLine(x2, y1, x2, y2, color);
+    LCD_GateReady(lcd);
+    LCD_PROF_ENTER(lcd, LCD_STAT_RECT);
+    LCDx_DrawLine(lcd, x1, y1, x2, y1, color);
+    LCDx_DrawLine(lcd, x1, y1, x1, y2, color);
+    LCDx_DrawLine(lcd, x1, y2, x2, y2, color);
+    LCDx_DrawLine(lcd, x2, y1, x2, y2, color);
+    LCD_PROF_LEAVE(lcd);
 }
 
 /**
  * @brief 画圆
+ * @param lcd LCD实例
  * @param x0 圆心X坐标
  * @param y0 圆心Y坐标
  * @param r 半径
@@ -1058,11 +2645,13 @@ void LCD_DrawRectangle(u16 x1, u16 y1, u16 x2, u16 y2, u16 color)
  * 2. 对称绘制8个点
  * 3. 使用批量绘制函数一次性传输
  */
-void Draw_Circle(u16 x0, u16 y0, u8 r, u16 color)
+void LCDx_Draw_Circle(lcd_st7789_t *lcd, u16 x0, u16 y0, u8 r, u16 color)
 {
 
     int a, b;
     int di;
+
+    LCD_GateReady(lcd);
     a = 0;
     b = r;
     di = 3 - (r << 1); // 判断下个点位置的标志
@@ -1072,6 +2661,8 @@ void Draw_Circle(u16 x0, u16 y0, u8 r, u16 color)
     u16 points_y[512];
     u16 point_count = 0;
 
+    LCD_PROF_ENTER(lcd, LCD_STAT_CIRCLE);
+
     while (a <= b)
     {
         // 存储8个对称点到缓冲区
@@ -1096,7 +2687,7 @@ void Draw_Circle(u16 x0, u16 y0, u8 r, u16 color)
         if (point_count >= 500)
         {
             // 使用批量绘制函数一次性处理所有点
-            LCD_DrawPoints(points_x, points_y, point_count, color);
+            LCDx_DrawPoints(lcd, points_x, points_y, point_count, color);
             point_count = 0; // 重置计数器
         }
 
@@ -1115,24 +2706,32 @@ void Draw_Circle(u16 x0, u16 y0, u8 r, u16 color)
     if (point_count > 0)
     {
         // 使用批量绘制函数一次性处理所有点
-        LCD_DrawPoints(points_x, points_y, point_count, color);
+        LCDx_DrawPoints(lcd, points_x, points_y, point_count, color);
     }
+    LCD_PROF_LEAVE(lcd);
 }
 
 /**
  * @brief 设置LCD扫描方向
+ * @param lcd LCD实例
  * @param dir 方向参数(0~7)
  *
  * 功能说明：
  * 1. 配置扫描方向寄存器
  * 2. 影响显示内容方向
  * 3. 支持8种方向设置
+ * 4. 按方向换算面板在GRAM中的偏移，并把窗口设为全屏
  */
-void LCD_Scan_Dir(u8 dir)
+void LCDx_Scan_Dir(lcd_st7789_t *lcd, u8 dir)
 {
-
     u16 regval = 0;
     u8 dirreg = 0;
+    u16 panel_x, panel_y;
+    u16 col_off, row_off;
+
+    LCD_GateReady(lcd);
+    panel_x = lcd->panel ? lcd->panel->x_off : 0;
+    panel_y = lcd->panel ? lcd->panel->y_off : 0;
     switch (dir)
     {
     case 0:
@@ -1160,7 +2759,6 @@ void LCD_Scan_Dir(u8 dir)
         dir = 2;
         break;
     }
-    rt_kprintf("dir:%d\n", dir);
     switch (dir)
     {
     case L2R_U2D: // 从左到右,从上到下
@@ -1191,23 +2789,21 @@ void LCD_Scan_Dir(u8 dir)
     }
     dirreg = 0X36;
     regval |= 0x00; // 0x08 0x00  红蓝反色可以通过这里修改
-    rt_kprintf("regval:%x\n", regval);
-    LCD_WriteReg(dirreg, regval);
+    LCD_WriteReg(lcd, dirreg, regval);
+    lcd->madctl = regval;
 
-    LCD_WR_REG(lcddev.setxcmd);
-    LCD_WR_DATA(0);
-    LCD_WR_DATA(0);
-    LCD_WR_DATA((lcddev.width - 1) >> 8);
-    LCD_WR_DATA((lcddev.width - 1) & 0XFF);
-    LCD_WR_REG(lcddev.setycmd);
-    LCD_WR_DATA(0);
-    LCD_WR_DATA(0);
-    LCD_WR_DATA((lcddev.height - 1) >> 8);
-    LCD_WR_DATA((lcddev.height - 1) & 0XFF);
+    // GRAM偏移：MX/MY镜像后偏移取GRAM另一侧，MV交换后列地址对应面板行
+    col_off = (regval & 0x40) ? LCD_GRAM_W - lcd->panel_w - panel_x : panel_x;
+    row_off = (regval & 0x80) ? LCD_GRAM_H - lcd->panel_h - panel_y : panel_y;
+    lcd->x_off = (regval & 0x20) ? row_off : col_off;
+    lcd->y_off = (regval & 0x20) ? col_off : row_off;
+
+    LCD_SetWindows(lcd, 0, 0, lcd->dev->width, lcd->dev->height);
 }
 
 /**
  * @brief 设置LCD显示方向
+ * @param lcd LCD实例
  * @param dir 方向(0-竖屏,1-横屏)
  *
  * 功能说明：
@@ -1215,276 +2811,3297 @@ void LCD_Scan_Dir(u8 dir)
  * 2. 更新宽高值
  * 3. 设置默认扫描方向
  */
-void LCD_Display_Dir(u8 dir)
+void LCDx_Display_Dir(lcd_st7789_t *lcd, u8 dir)
 {
+    LCD_GateReady(lcd);
     if (dir == 0)
     {
-        lcddev.dir = 0; // 竖屏
-        lcddev.width = LCD_W;
-        lcddev.height = LCD_H;
-
-        lcddev.wramcmd = 0X2C;
-        lcddev.setxcmd = 0X2A;
-        lcddev.setycmd = 0X2B;
-        DFT_SCAN_DIR = U2D_R2L; // 竖显-设定显示方向
+        lcd->dev->dir = 0; // 竖屏
+        lcd->dev->width = lcd->panel_w;
+        lcd->dev->height = lcd->panel_h;
+
+        lcd->dev->wramcmd = 0X2C;
+        lcd->dev->setxcmd = 0X2A;
+        lcd->dev->setycmd = 0X2B;
+        lcd->scan_dir = U2D_R2L; // 竖显-设定显示方向
     }
     else // 横屏
     {
-        lcddev.dir = 1;
-        lcddev.width = LCD_H;
-        lcddev.height = LCD_W;
-
-        lcddev.wramcmd = 0X2C;
-        lcddev.setxcmd = 0X2A;
-        lcddev.setycmd = 0X2B;
-        DFT_SCAN_DIR = L2R_U2D; // 横显-设定显示方向
+        lcd->dev->dir = 1;
+        lcd->dev->width = lcd->panel_h;
+        lcd->dev->height = lcd->panel_w;
+
+        lcd->dev->wramcmd = 0X2C;
+        lcd->dev->setxcmd = 0X2A;
+        lcd->dev->setycmd = 0X2B;
+        lcd->scan_dir = L2R_U2D; // 横显-设定显示方向
     }
-    LCD_Scan_Dir(DFT_SCAN_DIR); // 默认扫描方向
+    if (lcd == &lcd_default)
+        DFT_SCAN_DIR = lcd->scan_dir;
+    LCDx_Scan_Dir(lcd, lcd->scan_dir); // 默认扫描方向
 }
 
 /**
- * @brief 颜色块填充
- * @param sx 起始X坐标
- * @param sy 起始Y坐标
- * @param ex 结束X坐标
- * @param ey 结束Y坐标
- * @param color 颜色数据指针(RGB565格式)
+ * @brief 设置局部显示区域
+ * @param lcd LCD实例
+ * @param start_row 起始行(面板物理行,即竖屏坐标下的Y)
+ * @param end_row 结束行(面板物理行)
  *
  * 功能说明：
- * 1. 设置显示窗口
- * 2. 使用批量传输优化
- * 3. 支持任意矩形区域填充
- * 4. 显著提升显示效率
+ * 1. 发送PTLAR(0x30)命令设置局部显示的行范围
+ * 2. 仅在局部显示模式下生效，区域外的行不再被驱动
+ * 3. 参数被保存，LCD_Init后自动恢复
+ *
+ * 注意：
+ * - 行号是面板门线(Gate)方向，与当前横竖屏无关；
+ *   横屏时局部区域对应的是一段竖直条带
+ * - start_row大于end_row时为环绕区域(跨越最后一行回到第0行)
  */
-void LCD_Color_Fill(u16 sx, u16 sy, u16 ex, u16 ey, u16 *color)
+void LCDx_SetPartialArea(lcd_st7789_t *lcd, u16 start_row, u16 end_row)
 {
+    u16 off;
 
-    u16 width = ex - sx + 1;    // 填充宽度
-    u16 height = ey - sy + 1;   // 填充高度
-    u32 total = width * height; // 总像素数
-    u32 batch_size, i, j, k = 0;
-    u32 current_batch;
-
-    // 设置填充窗口
-    LCD_SetWindows(sx, sy, width, height);
-    LCD_WriteRAM_Prepare(); // 准备写入GRAM
-    LCD_DC_SET;             // 设置为数据模式
-
-    // 计算每次批量传输的像素数量
-    batch_size = LCD_BATCH_BUFFER_SIZE / 2; // 每个像素2字节
+    LCD_GateReady(lcd);
+    off = lcd->panel ? lcd->panel->y_off : 0;
+    if (start_row >= lcd->panel_h)
+        start_row = lcd->panel_h - 1;
+    if (end_row >= lcd->panel_h)
+        end_row = lcd->panel_h - 1;
 
-    // 分批次发送数据
-    for (i = 0; i < total; i += batch_size)
-    {
-        // 计算本批次要传输的实际像素数
-        current_batch = (i + batch_size > total) ? (total - i) : batch_size;
+    lcd->mode.start_row = start_row;
+    lcd->mode.end_row = end_row;
 
-        // 将当前批次的RGB565数据转换为字节流
-        for (j = 0; j < current_batch; j++)
-        {
-            u16 clr = color[k++];                 // 获取当前像素颜色
-            batch_buffer[j * 2] = clr >> 8;       // 高字节
-            batch_buffer[j * 2 + 1] = clr & 0xFF; // 低字节
-        }
+    LCD_WR_ADDR(lcd, 0x30, start_row + off, end_row + off);
+}
 
-        // 发送批量数据
-        rt_spi_send(lcd_dev, batch_buffer, current_batch * 2); // 每像素2字节
-    }
+/**
+ * @brief 局部显示模式开关
+ * @param lcd LCD实例
+ * @param enable 1-进入局部显示模式(PTLON) 0-恢复正常显示模式(NORON)
+ *
+ * 功能说明：
+ * 1. 进入后只有LCD_SetPartialArea设置的行被刷新，其余区域消隐
+ * 2. 配合LCD_IdleMode可把常亮的小区域(如时钟)功耗降到最低
+ * 3. GRAM写入不受影响，退出后全屏内容立即可见
+ */
+void LCDx_PartialMode(lcd_st7789_t *lcd, u8 enable)
+{
+    LCD_GateReady(lcd);
+    lcd->mode.partial = enable ? 1 : 0;
+    LCD_WR_REG(lcd, lcd->mode.partial ? 0x12 : 0x13);
 }
 
 /**
- * @brief 在指定区域内填充指定数据(LVGL优化版)
- * @param x 左上角起始X坐标
- * @param y 左上角起始Y坐标
- * @param x2 右下角结束X坐标
- * @param y2 右下角结束Y坐标
- * @param pData 数据指针(RGB565格式)
+ * @brief 空闲模式开关
+ * @param lcd LCD实例
+ * @param enable 1-进入空闲模式(IDMON) 0-退出空闲模式(IDMOFF)
+ *
  * 功能说明：
- * 1. 适用于LVGL移植的disp_flush函数
- * 2. 使用一次性SPI传输提高效率
- * 3. 支持16位RGB565格式数据(高位在前)
- * 4. 针对大数据量优化，显著提升刷新速度
+ * 1. 空闲模式下每个颜色分量只取最高位，仅显示8色
+ * 2. 面板驱动电压降低，适合电池供电时的待机画面
  */
-void LCD_DispFlush(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, const uint16_t *pData)
+void LCDx_IdleMode(lcd_st7789_t *lcd, u8 enable)
 {
-    // 计算宽度和高度
-    uint16_t width = x2 - x1 + 1;
-    uint16_t height = y2 - y1 + 1;
+    LCD_GateReady(lcd);
+    lcd->mode.idle = enable ? 1 : 0;
+    LCD_WR_REG(lcd, lcd->mode.idle ? 0x39 : 0x38);
+}
 
-    // 总像素数
-    uint32_t total_size = width * height;
-    uint32_t batch_size = LCD_BATCH_BUFFER_SIZE / 2; // 每批次处理的像素数量(2字节/像素)
-    uint32_t bytes_to_send, current_batch;
-    uint32_t i = 0;
+/**
+ * @brief 设置帧率(FRCTRL2)
+ * @param lcd LCD实例
+ * @param rtna 每行时钟数RTNA(0x00~0x1F)
+ *
+ * 功能说明：
+ * 1. 帧率 = 10MHz / ((320 + FPA + BPA) * (250 + RTNA * 16))
+ * 2. 默认门廊下0x00约119Hz，0x0F约60Hz，0x1F约39Hz
+ * 3. 降低帧率可延长每帧时间窗口，配合TE减少撕裂；提高帧率使动画更流畅
+ * 4. 参数被保存，LCD_Init后自动恢复
+ */
+void LCDx_SetFrameRate(lcd_st7789_t *lcd, u8 rtna)
+{
+    LCD_GateReady(lcd);
+    lcd->timing.rtna = rtna & 0x1F;
+    LCD_WriteReg(lcd, 0xc6, lcd->timing.rtna); // NLA=0: 点反转
 
-    // 设置窗口
-    LCD_SetWindows(x1, y1, width, height);
-    LCD_WriteRAM_Prepare(); // 准备写入GRAM
-    LCD_DC_SET;             // 设置为数据模式
+#ifdef PKG_ST7789_USING_TE
+    lcd->te_period = 0; // 帧周期改变，重新测量
+#endif
+}
 
-    // 分批次发送数据(处理大于缓冲区大小的数据)
-    while (i < total_size)
-    {
-        // 计算本批次要传输的实际像素数
-        current_batch = (i + batch_size > total_size) ? (total_size - i) : batch_size;
-        bytes_to_send = current_batch * 2; // 每像素2字节
+/**
+ * @brief 按目标刷新率选择最接近的RTNA
+ * @param lcd LCD实例
+ * @param hz 目标刷新率(Hz)
+ *
+ * 功能说明：
+ * 1. 按当前门廊设置反算RTNA并取整
+ * 2. 超出可调范围时取边界值
+ */
+void LCDx_SetRefreshRate(lcd_st7789_t *lcd, u16 hz)
+{
+    rt_uint32_t lines;
+    rt_uint32_t clocks;
+    rt_uint32_t rtna;
 
-        // 填充发送缓冲区
-        for (uint32_t j = 0; j < current_batch; j++)
-        {
-            uint16_t color = pData[i + j];
-            batch_buffer[j * 2] = color >> 8;       // 高字节
-            batch_buffer[j * 2 + 1] = color & 0xFF; // 低字节
-        }
+    LCD_GateReady(lcd);
+    lines = LCD_GATE_LINES + lcd->timing.fpa + lcd->timing.bpa;
+    if (hz == 0)
+        hz = 1;
 
-        // 一次性发送数据块
-        rt_spi_send(lcd_dev, batch_buffer, bytes_to_send);
+    clocks = LCD_OSC_HZ / (hz * lines); // 每行所需时钟数
+    rtna = (clocks > 250) ? (clocks - 250 + 8) / 16 : 0;
+    if (rtna > 0x1F)
+        rtna = 0x1F;
 
-        // 更新发送位置
-        i += current_batch;
-    }
+    LCDx_SetFrameRate(lcd, rtna);
 }
 
-/* 快速方向切换函数实现 */
-void LCD_SetPortrait(void)
+/**
+ * @brief 设置门廊(PORCTRL)
+ * @param lcd LCD实例
+ * @param back_porch 后门廊行数(0x01~0x7F)
+ * @param front_porch 前门廊行数(0x01~0x7F)
+ *
+ * 功能说明：
+ * 1. 门廊越长，消隐期越长，TE后可无撕裂写入的时间窗口越大
+ * 2. 门廊同时计入帧周期，会略微降低帧率
+ * 3. 参数被保存，LCD_Init后自动恢复
+ */
+void LCDx_SetPorch(lcd_st7789_t *lcd, u8 back_porch, u8 front_porch)
 {
-    LCD_Scan_Dir(PORTRAIT);
-    lcddev.dir = 0; // 竖屏
-    lcddev.width = LCD_W;
-    lcddev.height = LCD_H;
+    LCD_GateReady(lcd);
+    lcd->timing.bpa = back_porch ? (back_porch & 0x7F) : 1;
+    lcd->timing.fpa = front_porch ? (front_porch & 0x7F) : 1;
+
+    LCD_WritePorch(lcd);
+
+#ifdef PKG_ST7789_USING_TE
+    lcd->te_period = 0;
+#endif
 }
 
-void LCD_SetLandscape(void)
+/**
+ * @brief 获取当前面板刷新率
+ * @param lcd LCD实例
+ * @return 刷新率(单位0.1Hz)，如593表示59.3Hz
+ */
+u16 LCDx_GetFrameRate(lcd_st7789_t *lcd)
 {
-    LCD_Scan_Dir(LANDSCAPE);
-    lcddev.dir = 1; // 横屏
-    lcddev.width = LCD_H;
-    lcddev.height = LCD_W;
+    rt_uint32_t lines;
+    rt_uint32_t clocks;
+
+    LCD_GateReady(lcd);
+    lines = LCD_GATE_LINES + lcd->timing.fpa + lcd->timing.bpa;
+    clocks = 250 + lcd->timing.rtna * 16;
+    return (u16)(LCD_OSC_HZ * 10 / (lines * clocks));
 }
 
 /**
- * @brief 绘制测试图案
+ * @brief 估算区域刷新可达到的帧率
+ * @param lcd LCD实例
+ * @param width 区域宽度(像素)
+ * @param height 区域高度(像素)
+ * @param te_sync 0-仅受SPI带宽限制 1-每次刷新对齐TE
+ * @return 帧率(单位0.1fps)
  *
  * 功能说明：
- * 1. 绘制9宫格色块
- * 2. 每种颜色不同亮度
- * 3. 用于LCD功能测试
+ * 1. te_sync=0：SPI时钟 / (像素数 * 16bit)，与面板刷新率无关
+ * 2. te_sync=1：传输需占用整数个面板帧，结果为刷新率 / 所占帧数
+ * 3. 用于在不同帧率设置间权衡撕裂窗口与动画流畅度
  */
-static void LCD_DrawTestPattern(void)
+u16 LCDx_GetFlushRate(lcd_st7789_t *lcd, u16 width, u16 height, u8 te_sync)
 {
-    LOG_D("Starting optimized test pattern...");
+    rt_uint32_t bits = (rt_uint32_t)width * height * 16;
+    rt_uint32_t spi_rate, panel_rate, frames;
 
-    /* 确保背光开启 */
-#if (BACKLIGHT_ACTIVE_LEVEL == 1)
-    LCD_BLK_SET;
+    LCD_GateReady(lcd);
+    if (bits == 0 || lcd->spi_hz == 0)
+        return 0;
+
+    spi_rate = (rt_uint32_t)((rt_uint64_t)lcd->spi_hz * 10 / bits);
+    if (!te_sync)
+        return (u16)(spi_rate > 0xFFFF ? 0xFFFF : spi_rate);
+
+    panel_rate = LCDx_GetFrameRate(lcd);
+    if (spi_rate == 0)
+        return 0;
+    frames = (panel_rate + spi_rate - 1) / spi_rate; // 一次传输横跨的面板帧数(向上取整)
+
+    return (u16)(panel_rate / (frames ? frames : 1));
+}
+
+/**
+ * @brief 恢复局部显示/空闲模式
+ * @param lcd LCD实例
+ *
+ * 功能说明：
+ * 1. 面板复位后模式寄存器回到默认值
+ * 2. 按保存的状态重新下发PTLAR/PTLON/IDMON
+ */
+static void LCD_RestoreModes(lcd_st7789_t *lcd)
+{
+    if (lcd->mode.partial)
+    {
+        LCDx_SetPartialArea(lcd, lcd->mode.start_row, lcd->mode.end_row);
+        LCDx_PartialMode(lcd, 1);
+    }
+    if (lcd->mode.idle)
+    {
+        LCDx_IdleMode(lcd, 1);
+    }
+#ifdef PKG_ST7789_USING_TE
+    if (lcd->te_enabled)
+    {
+        LCD_WriteReg(lcd, 0x35, 0x00); // TEON
+    }
+#endif
+}
+
+#ifdef PKG_ST7789_USING_TE
+/**
+ * @brief TE引脚中断服务函数
+ * @param args 所属LCD实例
+ *
+ * 功能说明：
+ * 1. 每帧消隐期开始时由面板TE输出上升沿触发
+ * 2. 记录时刻并平滑估算帧周期
+ * 3. 释放信号量唤醒LCDx_WaitVSync
+ */
+static void LCD_TE_IrqHandler(void *args)
+{
+    lcd_st7789_t *lcd = (lcd_st7789_t *)args;
+    rt_tick_t now = rt_tick_get();
+    rt_tick_t period = now - lcd->te_tick;
+
+    if (period > 0 && period < LCD_TE_PERIOD_MAX)
+    {
+        // 一阶低通滤波，抵消tick量化误差
+        lcd->te_period = lcd->te_period ? (lcd->te_period * 3 + period + 2) / 4 : period;
+    }
+    lcd->te_tick = now;
+    rt_sem_release(&lcd->te_sem);
+}
+#endif
+
+/**
+ * @brief TE输出与引脚中断开关
+ * @param lcd LCD实例
+ * @param enable 1-开启(TEON 0x35,仅V-Blank) 0-关闭(TEOFF 0x34)
+ * @return RT_EOK成功，未配置TE引脚时返回-RT_ENOSYS
+ *
+ * 功能说明：
+ * 1. 开启时配置TE引脚为输入并挂接上升沿中断
+ * 2. 通知面板在每帧消隐期输出TE脉冲
+ * 3. 状态被保存，LCDx_Init后自动恢复
+ */
+rt_err_t LCDx_TE_Enable(lcd_st7789_t *lcd, u8 enable)
+{
+#ifdef PKG_ST7789_USING_TE
+    LCD_GateReady(lcd);
+    if (lcd->te_pin < 0)
+        return -RT_ENOSYS;
+
+    if (enable)
+    {
+        if (!lcd->te_inited)
+        {
+            rt_sem_init(&lcd->te_sem, "lcd_te", 0, RT_IPC_FLAG_FIFO);
+            lcd->te_inited = 1;
+        }
+        lcd->te_period = 0;
+        rt_pin_mode(lcd->te_pin, PIN_MODE_INPUT);
+        rt_pin_attach_irq(lcd->te_pin, PIN_IRQ_MODE_RISING, LCD_TE_IrqHandler, lcd);
+        rt_pin_irq_enable(lcd->te_pin, PIN_IRQ_ENABLE);
+        LCD_WriteReg(lcd, 0x35, 0x00); // TEON, M=0: 仅V-Blank输出
+    }
+    else
+    {
+        LCD_WR_REG(lcd, 0x34); // TEOFF
+        if (lcd->te_enabled)
+        {
+            rt_pin_irq_enable(lcd->te_pin, PIN_IRQ_DISABLE);
+            rt_pin_detach_irq(lcd->te_pin);
+        }
+    }
+    lcd->te_enabled = enable ? 1 : 0;
+
+    return RT_EOK;
 #else
-    LCD_BLK_CLR;
+    (void)lcd;
+    (void)enable;
+    return -RT_ENOSYS;
 #endif
+}
 
-    /* 先清屏为白色 */
-    LCD_Clear(WHITE);
-    rt_thread_mdelay(100);
+/**
+ * @brief 等待下一个垂直同步(TE沿)
+ * @param lcd LCD实例
+ * @param timeout 超时时间(ms)，RT_WAITING_FOREVER为永久等待
+ * @return RT_EOK成功，-RT_ETIMEOUT超时，TE未开启时返回-RT_ENOSYS
+ *
+ * 功能说明：
+ * 1. 丢弃之前累积的TE事件，只等待"下一个"消隐期
+ * 2. 适合动画循环：LCD_WaitVSync后立即刷新，一帧一次
+ */
+rt_err_t LCDx_WaitVSync(lcd_st7789_t *lcd, rt_int32_t timeout)
+{
+#ifdef PKG_ST7789_USING_TE
+    LCD_GateReady(lcd);
+    if (!lcd->te_enabled)
+        return -RT_ENOSYS;
 
-    /* 计算区域尺寸 */
-    uint16_t w = lcddev.width / 3;
-    uint16_t h = lcddev.height / 3;
+    if (timeout != RT_WAITING_FOREVER)
+        timeout = rt_tick_from_millisecond(timeout);
 
-    /* 绘制9个色块 */
-    for (int row = 0; row < 3; row++)
+    rt_sem_control(&lcd->te_sem, RT_IPC_CMD_RESET, RT_NULL);
+    return rt_sem_take(&lcd->te_sem, timeout);
+#else
+    (void)lcd;
+    (void)timeout;
+    return -RT_ENOSYS;
+#endif
+}
+
+/**
+ * @brief 颜色块填充
+ * @param lcd LCD实例
+ * @param sx 起始X坐标
+ * @param sy 起始Y坐标
+ * @param ex 结束X坐标
+ * @param ey 结束Y坐标
+ * @param color 颜色数据指针(RGB565格式)
+ *
+ * 功能说明：
+ * 1. 设置显示窗口
+ * 2. 使用批量传输优化
+ * 3. 支持任意矩形区域填充
+ * 4. 显著提升显示效率
+ */
+void LCDx_Color_Fill(lcd_st7789_t *lcd, u16 sx, u16 sy, u16 ex, u16 ey, u16 *color)
+{
+
+    u16 width = ex - sx + 1;    // 填充宽度
+    u16 height = ey - sy + 1;   // 填充高度
+    u32 total = width * height; // 总像素数
+    u32 batch_size, i, j, k = 0;
+    u32 current_batch;
+
+    LCD_GateReady(lcd);
+    LCD_PROF_ENTER(lcd, LCD_STAT_COLOR_FILL);
+
+    // 设置填充窗口
+    LCD_SetWindows(lcd, sx, sy, width, height);
+    LCD_WriteRAM_Prepare(lcd); // 准备写入GRAM
+    LCD_DC_HIGH(lcd);             // 设置为数据模式
+
+    // 计算每次批量传输的像素数量
+    batch_size = LCD_BATCH_BUFFER_SIZE / 2; // 每个像素2字节
+
+    // 分批次发送数据
+    for (i = 0; i < total; i += batch_size)
     {
-        for (int col = 0; col < 3; col++)
+        // 计算本批次要传输的实际像素数
+        current_batch = (i + batch_size > total) ? (total - i) : batch_size;
+
+        // 将当前批次的RGB565数据转换为字节流
+        for (j = 0; j < current_batch; j++)
         {
-            uint16_t color;
-            /* 确定基础颜色 */
-            switch (col)
-            {
-            case 0:
-                color = RED;
-                break;
-            case 1:
-                color = GREEN;
-                break;
-            case 2:
-                color = BLUE;
-                break;
-            }
+            u16 clr = color[k++];                 // 获取当前像素颜色
+            lcd->batch[j * 2] = clr >> 8;       // 高字节
+            lcd->batch[j * 2 + 1] = clr & 0xFF; // 低字节
+        }
 
-            /* 调整亮度 */
-            switch (row)
-            {
-            case 0:
-                color |= 0xFFFF;
-                break; // 全亮
-            case 1:
-                color &= 0xFFE0;
-                break; // 半亮
-            case 2:
-                color &= 0xF800;
-                break; // 暗
-            }
+        // 发送批量数据
+        LCD_SpiSend(lcd, lcd->batch, current_batch * 2); // 每像素2字节
+    }
+    LCD_PROF_LEAVE(lcd);
+}
 
-            /* 计算区域坐标 */
-            uint16_t x1 = col * w;
-            uint16_t y1 = row * h;
-            uint16_t x2 = (col == 2) ? lcddev.width - 1 : (col + 1) * w - 1;
-            uint16_t y2 = (row == 2) ? lcddev.height - 1 : (row + 1) * h - 1;
+/**
+ * @brief 在指定区域内填充指定数据(LVGL优化版)
+ * @param lcd LCD实例
+ * @param x 左上角起始X坐标
+ * @param y 左上角起始Y坐标
+ * @param x2 右下角结束X坐标
+ * @param y2 右下角结束Y坐标
+ * @param pData 数据指针(RGB565格式)
+ * 功能说明：
+ * 1. 适用于LVGL移植的disp_flush函数
+ * 2. 使用一次性SPI传输提高效率
+ * 3. 支持16位RGB565格式数据(高位在前)
+ * 4. 针对大数据量优化，显著提升刷新速度
+ */
+void LCDx_DispFlush(lcd_st7789_t *lcd, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, const uint16_t *pData)
+{
+    // 计算宽度和高度
+    uint16_t width = x2 - x1 + 1;
+    uint16_t height = y2 - y1 + 1;
 
-            LOG_D("Drawing block %d-%d: (%d,%d)-(%d,%d) color=0x%04X",
-                  row, col, x1, y1, x2, y2, color);
+    // 总像素数
+    uint32_t total_size = width * height;
+    uint32_t batch_size = LCD_BATCH_BUFFER_SIZE / 2; // 每批次处理的像素数量(2字节/像素)
+    uint32_t bytes_to_send, current_batch;
+    uint32_t i = 0;
 
-            /* 填充区域 */
-            LCD_Fill(x1, y1, x2, y2, color);
+    LCD_GateReady(lcd);
+    LCD_PROF_ENTER(lcd, LCD_STAT_FLUSH);
 
-            /* 添加短暂延时防止SPI过载 */
-            rt_thread_mdelay(10);
+    // 大区域使用12位格式传输
+    if (LCD_Use444(lcd, total_size))
+    {
+        LCD_SetColmod(lcd, LCD_PIXFMT_RGB444);
+        LCD_SetWindows(lcd, x1, y1, width, height);
+        LCD_WriteRAM_Prepare(lcd);
+        LCD_DC_HIGH(lcd);
+        LCD_Flush444(lcd, pData, total_size);
+        LCD_SetColmod(lcd, LCD_PIXFMT_RGB565);
+        LCD_PROF_LEAVE(lcd);
+        return;
+    }
+
+    // 设置窗口
+    LCD_SetWindows(lcd, x1, y1, width, height);
+    LCD_WriteRAM_Prepare(lcd); // 准备写入GRAM
+    LCD_DC_HIGH(lcd);             // 设置为数据模式
+
+    // 分批次发送数据(处理大于缓冲区大小的数据)
+    while (i < total_size)
+    {
+        // 计算本批次要传输的实际像素数
+        current_batch = (i + batch_size > total_size) ? (total_size - i) : batch_size;
+        bytes_to_send = current_batch * 2; // 每像素2字节
+
+        // 填充发送缓冲区
+        for (uint32_t j = 0; j < current_batch; j++)
+        {
+            uint16_t color = pData[i + j];
+            lcd->batch[j * 2] = color >> 8;       // 高字节
+            lcd->batch[j * 2 + 1] = color & 0xFF; // 低字节
         }
+
+        // 一次性发送数据块
+        LCD_SpiSend(lcd, lcd->batch, bytes_to_send);
+
+        // 更新发送位置
+        i += current_batch;
     }
-    LOG_D("Test pattern complete");
+    LCD_PROF_LEAVE(lcd);
 }
 
-/* RT-Thread设备初始化 */
-static void lcd_pin_init(void)
+/**
+ * @brief TE同步的区域刷屏
+ * @param lcd LCD实例
+ * @param x1 左上角起始X坐标
+ * @param y1 左上角起始Y坐标
+ * @param x2 右下角结束X坐标
+ * @param y2 右下角结束Y坐标
+ * @param pData 数据指针(RGB565格式)
+ *
+ * 功能说明：
+ * 1. 等待TE沿(消隐期开始)后再写GRAM，避免画面撕裂
+ * 2. 竖屏时用户行即面板扫描行：
+ *    - SPI写一行比面板扫描一行慢时，延迟到扫描线越过y1再写，
+ *      写入指针始终落后于扫描线，本帧显示旧内容、下一帧完整显示新内容
+ *    - SPI更快时立即开始写，写入指针始终领先扫描线
+ * 3. 横屏时扫描方向与行写入方向正交，仅做TE对齐
+ * 4. 未开启TE时退化为LCD_DispFlush
+ *
+ * 注意：区域写入时间需小于一个帧周期加该区域扫描时间，否则仍会出现一次撕裂
+ */
+void LCDx_DispFlushSync(lcd_st7789_t *lcd, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, const uint16_t *pData)
 {
-    rt_pin_mode(LCD_DC_PIN, PIN_MODE_OUTPUT);
-    rt_pin_mode(LCD_RES_PIN, PIN_MODE_OUTPUT);
-    rt_pin_mode(LCD_BLK_PIN, PIN_MODE_OUTPUT);
-    rt_pin_mode(LCD_CS_PIN, PIN_MODE_OUTPUT);
+    LCD_GateReady(lcd);
+    LCD_PROF_ENTER(lcd, LCD_STAT_FLUSH_SYNC);
+#ifdef PKG_ST7789_USING_TE
+    if (LCDx_WaitVSync(lcd, LCD_TE_PERIOD_MAX * 1000 / RT_TICK_PER_SECOND) == RT_EOK &&
+        lcd->dev->dir == 0 && lcd->te_period != 0 && lcd->spi_hz != 0)
+    {
+        // 一行的SPI写入时间与面板扫描时间(单位:us)
+        rt_uint32_t write_row_us = (rt_uint32_t)((x2 - x1 + 1) * 16ULL * 1000000 / lcd->spi_hz);
+        rt_uint32_t scan_row_us = (rt_uint32_t)(lcd->te_period * 1000000ULL / RT_TICK_PER_SECOND / lcd->panel_h);
+
+        if (write_row_us > scan_row_us && y1 > 0)
+        {
+            rt_tick_t lag = (rt_tick_t)((rt_uint32_t)y1 * lcd->te_period / lcd->panel_h);
+            if (lag > 0)
+                rt_thread_delay(lag);
+        }
+    }
+#endif
+    LCDx_DispFlush(lcd, x1, y1, x2, y2, pData);
+    LCD_PROF_LEAVE(lcd);
 }
 
-int spi_lcd_init(void)
+/**
+ * @brief 初始化调色板帧缓冲
+ * @param fb 帧缓冲对象
+ * @param bpp 每像素位数(8或4)
+ * @param width 画布宽度
+ * @param height 画布高度
+ * @param buf 索引数据缓冲区，RT_NULL时自动申请
+ * @return RT_EOK成功，-RT_EINVAL参数错误，-RT_ENOMEM内存不足
+ *
+ * 功能说明：
+ * 1. 每像素只存调色板索引，240x320画布8bpp占75KB，4bpp占37.5KB
+ * 2. 4bpp时每字节高4位为左侧像素
+ * 3. 调色板初始化为全黑，需调用LCD_PalFB_SetPalette设置
+ */
+rt_err_t LCD_PalFB_Init(lcd_pal_fb_t *fb, u8 bpp, u16 width, u16 height, u8 *buf)
 {
-    rt_err_t res = RT_EOK;
+    if (fb == RT_NULL || (bpp != 8 && bpp != 4) || width == 0 || height == 0)
+        return -RT_EINVAL;
 
-    /* 初始化引脚 */
-    lcd_pin_init();
+    fb->width = width;
+    fb->height = height;
+    fb->bpp = bpp;
+    fb->stride = (bpp == 8) ? width : (width + 1) / 2;
+    fb->buf = buf;
+    fb->owned = 0;
 
-    /* 附加SPI设备 */
-    rt_hw_spi_device_attach(LCD_SPI_BUS, "spi_lcd", LCD_CS_PIN);
+    if (fb->buf == RT_NULL)
+    {
+        fb->buf = rt_malloc((rt_size_t)fb->stride * height);
+        if (fb->buf == RT_NULL)
+        {
+            LOG_E("No memory for palette framebuffer!");
+            return -RT_ENOMEM;
+        }
+        fb->owned = 1;
+    }
 
-    /* 查找SPI设备 */
-    lcd_dev = (struct rt_spi_device *)rt_device_find("spi_lcd");
-    if (lcd_dev != RT_NULL)
+    rt_memset(fb->buf, 0, (rt_size_t)fb->stride * height);
+    rt_memset(fb->palette, 0, sizeof(fb->palette));
+
+    return RT_EOK;
+}
+
+/**
+ * @brief 释放调色板帧缓冲
+ * @param fb 帧缓冲对象
+ *
+ * 功能说明：只释放由LCD_PalFB_Init自动申请的缓冲区
+ */
+void LCD_PalFB_Deinit(lcd_pal_fb_t *fb)
+{
+    if (fb->owned)
+        rt_free(fb->buf);
+    fb->buf = RT_NULL;
+    fb->owned = 0;
+}
+
+/**
+ * @brief 设置调色板
+ * @param fb 帧缓冲对象
+ * @param start 起始索引
+ * @param count 颜色个数
+ * @param colors 颜色数组(RGB565)
+ *
+ * 功能说明：
+ * 1. 颜色以发送字节序存放，刷新时直接整字拷贝，无需逐像素拆分高低字节
+ * 2. 只修改调色板后重新刷新即可实现整屏变色/渐隐等动画
+ */
+void LCD_PalFB_SetPalette(lcd_pal_fb_t *fb, u16 start, u16 count, const u16 *colors)
+{
+    u16 entries = (fb->bpp == 8) ? 256 : 16;
+
+    while (count-- && start < entries)
     {
-        /* 配置SPI参数 */
-        struct rt_spi_configuration spi_config;
-        spi_config.data_width = 8;
-        spi_config.max_hz = 25 * 1000 * 1000; /* 25MHz */
-        spi_config.mode = RT_SPI_MASTER | RT_SPI_MODE_0 | RT_SPI_MSB;
-        rt_spi_configure(lcd_dev, &spi_config);
+        fb->palette[start++] = LCD_TO_WIRE16(*colors);
+        colors++;
     }
-    else
+}
+
+/**
+ * @brief 在调色板帧缓冲中画点
+ * @param fb 帧缓冲对象
+ * @param x X坐标
+ * @param y Y坐标
+ * @param index 调色板索引
+ */
+void LCD_PalFB_DrawPoint(lcd_pal_fb_t *fb, u16 x, u16 y, u8 index)
+{
+    u8 *p;
+
+    if (x >= fb->width || y >= fb->height)
+        return;
+
+    if (fb->bpp == 8)
     {
-        res = -RT_ERROR;
-        LOG_E("SPI device not found!");
+        fb->buf[(u32)y * fb->stride + x] = index;
+        return;
     }
-    rt_thread_mdelay(25);
-    LCD_RES_CLR;
-    rt_thread_mdelay(25);
-    LCD_RES_SET;
-    rt_thread_mdelay(50);
 
-    /* 执行LCD初始化序列 */
-    LCD_INIT_CODE(Landscape);
-    rt_thread_mdelay(10); // 确保方向设置完成
+    p = &fb->buf[(u32)y * fb->stride + (x >> 1)];
+    if (x & 1)
+        *p = (*p & 0xF0) | (index & 0x0F);
+    else
+        *p = (*p & 0x0F) | (index << 4);
+}
+
+/**
+ * @brief 在调色板帧缓冲中填充矩形
+ * @param fb 帧缓冲对象
+ * @param sx 起始X坐标
+ * @param sy 起始Y坐标
+ * @param ex 结束X坐标
+ * @param ey 结束Y坐标
+ * @param index 调色板索引
+ *
+ * 功能说明：
+ * 1. 超出画布的部分被裁剪
+ * 2. 按行memset，4bpp时只单独处理首尾半字节
+ */
+void LCD_PalFB_Fill(lcd_pal_fb_t *fb, u16 sx, u16 sy, u16 ex, u16 ey, u8 index)
+{
+    u16 y;
+
+    if (sx >= fb->width || sy >= fb->height || sx > ex || sy > ey)
+        return;
+    if (ex >= fb->width)
+        ex = fb->width - 1;
+    if (ey >= fb->height)
+        ey = fb->height - 1;
+
+    for (y = sy; y <= ey; y++)
+    {
+        u8 *row = &fb->buf[(u32)y * fb->stride];
+
+        if (fb->bpp == 8)
+        {
+            rt_memset(row + sx, index, ex - sx + 1);
+            continue;
+        }
+
+        u16 x = sx;
+        u16 end = ex + 1;
+        if (x & 1) // 起始在字节右半
+        {
+            row[x >> 1] = (row[x >> 1] & 0xF0) | (index & 0x0F);
+            x++;
+        }
+        if (end & 1 && x < end) // 结束在字节左半
+        {
+            end--;
+            row[end >> 1] = (row[end >> 1] & 0x0F) | (index << 4);
+        }
+        if (x < end)
+            rt_memset(row + (x >> 1), (index & 0x0F) * 0x11, (end - x) >> 1);
+    }
+}
+
+/**
+ * @brief 清空调色板帧缓冲
+ * @param fb 帧缓冲对象
+ * @param index 调色板索引
+ */
+void LCD_PalFB_Clear(lcd_pal_fb_t *fb, u8 index)
+{
+    if (fb->bpp == 4)
+        index = (index & 0x0F) * 0x11;
+    rt_memset(fb->buf, index, (rt_size_t)fb->stride * fb->height);
+}
+
+/**
+ * @brief 刷新调色板帧缓冲的一个区域到屏幕
+ * @param lcd LCD实例
+ * @param fb 帧缓冲对象
+ * @param x 画布原点在屏幕上的X坐标
+ * @param y 画布原点在屏幕上的Y坐标
+ * @param sx 画布区域起始X
+ * @param sy 画布区域起始Y
+ * @param ex 画布区域结束X
+ * @param ey 画布区域结束Y
+ *
+ * 功能说明：
+ * 1. 设置一次窗口，逐行查调色板展开为RGB565写入batch_buffer
+ * 2. 缓冲区满即发送，跨行连续填充，内存占用与画布大小无关
+ * 3. 8bpp每像素一次查表，4bpp每字节两次查表
+ */
+void LCDx_PalFB_FlushArea(lcd_st7789_t *lcd, const lcd_pal_fb_t *fb, u16 x, u16 y, u16 sx, u16 sy, u16 ex, u16 ey)
+{
+    u16 *dst = (u16 *)lcd->batch;
+    const u16 *pal = fb->palette;
+    u32 fill = 0;
+    u16 row, w;
+
+    LCD_GateReady(lcd);
+    if (sx >= fb->width || sy >= fb->height || sx > ex || sy > ey)
+        return;
+    if (ex >= fb->width)
+        ex = fb->width - 1;
+    if (ey >= fb->height)
+        ey = fb->height - 1;
+    w = ex - sx + 1;
+
+    LCD_PROF_ENTER(lcd, LCD_STAT_FB_FLUSH);
+    LCD_SetWindows(lcd, x + sx, y + sy, w, ey - sy + 1);
+    LCD_WriteRAM_Prepare(lcd);
+    LCD_DC_HIGH(lcd);
+
+    for (row = sy; row <= ey; row++)
+    {
+        const u8 *src = &fb->buf[(u32)row * fb->stride];
+        u16 col = sx;
+
+        while (col <= ex)
+        {
+            // 本次最多展开到行尾或缓冲区满
+            u16 n = ex - col + 1;
+            if (n > LCD_BATCH_BUFFER_SIZE / 2 - fill)
+                n = LCD_BATCH_BUFFER_SIZE / 2 - fill;
+
+            u16 *d = dst + fill;
+            u16 i = 0;
+            if (fb->bpp == 8)
+            {
+                const u8 *s8 = src + col;
+                for (; i + 4 <= n; i += 4, s8 += 4)
+                {
+                    d[i] = pal[s8[0]];
+                    d[i + 1] = pal[s8[1]];
+                    d[i + 2] = pal[s8[2]];
+                    d[i + 3] = pal[s8[3]];
+                }
+                for (; i < n; i++)
+                    d[i] = pal[*s8++];
+            }
+            else
+            {
+                const u8 *s4 = src + (col >> 1);
+                if (col & 1)
+                    d[i++] = pal[*s4++ & 0x0F];
+                for (; i + 2 <= n; i += 2)
+                {
+                    u8 b = *s4++;
+                    d[i] = pal[b >> 4];
+                    d[i + 1] = pal[b & 0x0F];
+                }
+                if (i < n)
+                    d[i++] = pal[*s4 >> 4];
+            }
+
+            fill += n;
+            col += n;
+            if (fill == LCD_BATCH_BUFFER_SIZE / 2)
+            {
+                LCD_SpiSend(lcd, lcd->batch, fill * 2);
+                fill = 0;
+            }
+        }
+    }
+
+    if (fill > 0)
+        LCD_SpiSend(lcd, lcd->batch, fill * 2);
+    LCD_PROF_LEAVE(lcd);
+}
+
+/**
+ * @brief 刷新整个调色板帧缓冲到屏幕
+ * @param lcd LCD实例
+ * @param fb 帧缓冲对象
+ * @param x 画布左上角在屏幕上的X坐标
+ * @param y 画布左上角在屏幕上的Y坐标
+ */
+void LCDx_PalFB_Flush(lcd_st7789_t *lcd, const lcd_pal_fb_t *fb, u16 x, u16 y)
+{
+    LCD_GateReady(lcd);
+    LCDx_PalFB_FlushArea(lcd, fb, x, y, 0, 0, fb->width - 1, fb->height - 1);
+}
+
+/**
+ * @brief 初始化单色帧缓冲
+ * @param fb 帧缓冲对象
+ * @param width 画布宽度
+ * @param height 画布高度
+ * @param buf 位图缓冲区，RT_NULL时自动申请
+ * @return RT_EOK成功，-RT_EINVAL参数错误，-RT_ENOMEM内存不足
+ *
+ * 功能说明：
+ * 1. 每像素1位，240x320画布仅占9.6KB
+ * 2. 每行(width+7)/8字节，每字节最高位为最左侧像素
+ * 3. 默认前景白色、背景黑色
+ */
+rt_err_t LCD_MonoFB_Init(lcd_mono_fb_t *fb, u16 width, u16 height, u8 *buf)
+{
+    if (fb == RT_NULL || width == 0 || height == 0)
+        return -RT_EINVAL;
+
+    fb->width = width;
+    fb->height = height;
+    fb->stride = (width + 7) / 8;
+    fb->buf = buf;
+    fb->owned = 0;
+
+    if (fb->buf == RT_NULL)
+    {
+        fb->buf = rt_malloc((rt_size_t)fb->stride * height);
+        if (fb->buf == RT_NULL)
+        {
+            LOG_E("No memory for mono framebuffer!");
+            return -RT_ENOMEM;
+        }
+        fb->owned = 1;
+    }
+
+    rt_memset(fb->buf, 0, (rt_size_t)fb->stride * height);
+    LCD_MonoFB_SetColors(fb, WHITE, BLACK);
+
+    return RT_EOK;
+}
+
+/**
+ * @brief 释放单色帧缓冲
+ * @param fb 帧缓冲对象
+ */
+void LCD_MonoFB_Deinit(lcd_mono_fb_t *fb)
+{
+    if (fb->owned)
+        rt_free(fb->buf);
+    fb->buf = RT_NULL;
+    fb->owned = 0;
+}
+
+/**
+ * @brief 设置单色帧缓冲的前景/背景色
+ * @param fb 帧缓冲对象
+ * @param fg 前景色(位为1)
+ * @param bg 背景色(位为0)
+ *
+ * 功能说明：
+ * 1. 重建16项半字节查找表，每项为4个发送字节序的像素
+ * 2. 刷新时每字节只需两次查表、8次16位写入
+ * 3. 只改颜色后重新刷新即可实现反色/主题切换
+ */
+void LCD_MonoFB_SetColors(lcd_mono_fb_t *fb, u16 fg, u16 bg)
+{
+    u16 f = LCD_TO_WIRE16(fg);
+    u16 b = LCD_TO_WIRE16(bg);
+    u8 n, i;
+
+    for (n = 0; n < 16; n++)
+    {
+        for (i = 0; i < 4; i++)
+        {
+            fb->lut[n][i] = (n & (0x08 >> i)) ? f : b;
+        }
+    }
+}
+
+/**
+ * @brief 清空单色帧缓冲
+ * @param fb 帧缓冲对象
+ * @param set 1-全部置为前景 0-全部置为背景
+ */
+void LCD_MonoFB_Clear(lcd_mono_fb_t *fb, u8 set)
+{
+    rt_memset(fb->buf, set ? 0xFF : 0x00, (rt_size_t)fb->stride * fb->height);
+}
+
+/**
+ * @brief 在单色帧缓冲中画点
+ * @param fb 帧缓冲对象
+ * @param x X坐标
+ * @param y Y坐标
+ * @param set 1-前景 0-背景
+ */
+void LCD_MonoFB_DrawPoint(lcd_mono_fb_t *fb, u16 x, u16 y, u8 set)
+{
+    u8 *p;
+
+    if (x >= fb->width || y >= fb->height)
+        return;
+
+    p = &fb->buf[(u32)y * fb->stride + (x >> 3)];
+    if (set)
+        *p |= 0x80 >> (x & 7);
+    else
+        *p &= ~(0x80 >> (x & 7));
+}
+
+/**
+ * @brief 在单色帧缓冲中填充矩形
+ * @param fb 帧缓冲对象
+ * @param sx 起始X坐标
+ * @param sy 起始Y坐标
+ * @param ex 结束X坐标
+ * @param ey 结束Y坐标
+ * @param set 1-前景 0-背景
+ *
+ * 功能说明：
+ * 1. 首尾字节用掩码处理，中间整字节memset
+ * 2. 超出画布的部分被裁剪
+ */
+void LCD_MonoFB_Fill(lcd_mono_fb_t *fb, u16 sx, u16 sy, u16 ex, u16 ey, u8 set)
+{
+    u16 y, first, last;
+    u8 lmask, rmask;
+
+    if (sx >= fb->width || sy >= fb->height || sx > ex || sy > ey)
+        return;
+    if (ex >= fb->width)
+        ex = fb->width - 1;
+    if (ey >= fb->height)
+        ey = fb->height - 1;
+
+    first = sx >> 3;
+    last = ex >> 3;
+    lmask = 0xFF >> (sx & 7);
+    rmask = 0xFF << (7 - (ex & 7));
+
+    for (y = sy; y <= ey; y++)
+    {
+        u8 *row = &fb->buf[(u32)y * fb->stride];
+
+        if (first == last)
+        {
+            u8 m = lmask & rmask;
+            row[first] = set ? (row[first] | m) : (row[first] & ~m);
+            continue;
+        }
+
+        row[first] = set ? (row[first] | lmask) : (row[first] & ~lmask);
+        if (last > first + 1)
+            rt_memset(row + first + 1, set ? 0xFF : 0x00, last - first - 1);
+        row[last] = set ? (row[last] | rmask) : (row[last] & ~rmask);
+    }
+}
+
+/**
+ * @brief 向单色帧缓冲位块传送1bpp位图
+ * @param fb 帧缓冲对象
+ * @param x 目标X坐标
+ * @param y 目标Y坐标
+ * @param src 源位图(行优先，每行(w+7)/8字节，最高位为最左侧像素)
+ * @param w 位图宽度
+ * @param h 位图高度
+ * @param rop 光栅操作LCD_ROP_COPY/LCD_ROP_OR/LCD_ROP_AND_NOT/LCD_ROP_XOR
+ *
+ * 功能说明：
+ * 1. 源字节按目标位偏移拆成左右两部分，每次处理8个像素
+ * 2. 超出画布的部分被裁剪
+ * 3. COPY覆盖目标，OR只画1，AND_NOT擦除1对应的位，XOR反色(光标)
+ */
+void LCD_MonoFB_Blit(lcd_mono_fb_t *fb, u16 x, u16 y, const u8 *src, u16 w, u16 h, u8 rop)
+{
+    u16 src_stride = (w + 7) / 8;
+    u8 shift = x & 7;
+    u16 row, i;
+
+    if (x >= fb->width || y >= fb->height)
+        return;
+    if (x + w > fb->width)
+        w = fb->width - x;
+    if (y + h > fb->height)
+        h = fb->height - y;
+
+    for (row = 0; row < h; row++)
+    {
+        const u8 *s = src + (u32)row * src_stride;
+        u8 *d = &fb->buf[(u32)(y + row) * fb->stride + (x >> 3)];
+        u16 remain = w;
+
+        for (i = 0; remain > 0; i++)
+        {
+            u8 bits = s[i];
+            u8 n = remain > 8 ? 8 : remain;
+            u16 mask = (u16)(0xFF00 >> n) & 0xFF; // 本字节有效位
+            u16 v, m;
+
+            remain -= n;
+            bits &= mask;
+            v = (u16)bits << (8 - shift); // 跨越两个目标字节
+            m = mask << (8 - shift);
+
+            for (u8 k = 0; k < 2; k++)
+            {
+                u8 vb = (k == 0) ? (v >> 8) : (v & 0xFF);
+                u8 mb = (k == 0) ? (m >> 8) : (m & 0xFF);
+                if (mb == 0)
+                    continue;
+
+                switch (rop)
+                {
+                case LCD_ROP_OR:
+                    d[k] |= vb;
+                    break;
+                case LCD_ROP_AND_NOT:
+                    d[k] &= ~vb;
+                    break;
+                case LCD_ROP_XOR:
+                    d[k] ^= vb;
+                    break;
+                default: // LCD_ROP_COPY
+                    d[k] = (d[k] & ~mb) | vb;
+                    break;
+                }
+            }
+            d++;
+        }
+    }
+}
+
+/**
+ * @brief 在单色帧缓冲中显示字符串
+ * @param fb 帧缓冲对象
+ * @param x 起始X坐标
+ * @param y 起始Y坐标
+ * @param size 字体大小(12/16)
+ * @param p 字符串
+ * @param set 1-字体为前景色 0-字体为背景色(反白)
+ *
+ * 功能说明：
+ * 1. 字模为列优先，逐位写入画布，字符背景同时被覆盖
+ * 2. 超出画布宽度时停止
+ */
+void LCD_MonoFB_ShowString(lcd_mono_fb_t *fb, u16 x, u16 y, u8 size, const char *p, u8 set)
+{
+    u8 col_bytes = size / 8 + ((size % 8) ? 1 : 0);
+    u8 csize = col_bytes * (size / 2);
+
+    while (*p >= ' ' && *p <= '~')
+    {
+        const u8 *pfont;
+
+        if (x + size / 2 > fb->width)
+            break;
+
+        if (size == 12)
+            pfont = asc2_1206[*p - ' '];
+        else if (size == 16)
+            pfont = asc2_1608[*p - ' '];
+        else
+            return;
+
+        for (u8 t = 0; t < csize; t++)
+        {
+            u8 temp = pfont[t];
+            u16 px = x + t / col_bytes;
+            u16 py = y + (t % col_bytes) * 8;
+
+            for (u8 b = 0; b < 8 && py + b < y + size; b++)
+            {
+                LCD_MonoFB_DrawPoint(fb, px, py + b, (temp & 0x80) ? set : !set);
+                temp <<= 1;
+            }
+        }
+
+        x += size / 2;
+        p++;
+    }
+}
+
+/**
+ * @brief 刷新单色帧缓冲的一个区域到屏幕
+ * @param lcd LCD实例
+ * @param fb 帧缓冲对象
+ * @param x 画布原点在屏幕上的X坐标
+ * @param y 画布原点在屏幕上的Y坐标
+ * @param sx 画布区域起始X
+ * @param sy 画布区域起始Y
+ * @param ex 画布区域结束X
+ * @param ey 画布区域结束Y
+ *
+ * 功能说明：
+ * 1. 设置一次窗口，逐字节查半字节表展开为前景/背景色写入batch_buffer
+ * 2. 区域首尾不满8像素的部分逐位展开
+ * 3. 缓冲区满即发送，跨行连续填充
+ */
+void LCDx_MonoFB_FlushArea(lcd_st7789_t *lcd, const lcd_mono_fb_t *fb, u16 x, u16 y, u16 sx, u16 sy, u16 ex, u16 ey)
+{
+    u16 *dst = (u16 *)lcd->batch;
+    const u32 cap = LCD_BATCH_BUFFER_SIZE / 2;
+    u32 fill = 0;
+    u16 row;
+
+    LCD_GateReady(lcd);
+    if (sx >= fb->width || sy >= fb->height || sx > ex || sy > ey)
+        return;
+    if (ex >= fb->width)
+        ex = fb->width - 1;
+    if (ey >= fb->height)
+        ey = fb->height - 1;
+
+    LCD_PROF_ENTER(lcd, LCD_STAT_FB_FLUSH);
+    LCD_SetWindows(lcd, x + sx, y + sy, ex - sx + 1, ey - sy + 1);
+    LCD_WriteRAM_Prepare(lcd);
+    LCD_DC_HIGH(lcd);
+
+    for (row = sy; row <= ey; row++)
+    {
+        const u8 *src = &fb->buf[(u32)row * fb->stride];
+        u16 col = sx;
+
+        while (col <= ex)
+        {
+            if (fill + 8 > cap)
+            {
+                LCD_SpiSend(lcd, lcd->batch, fill * 2);
+                fill = 0;
+            }
+
+            if ((col & 7) == 0 && col + 7 <= ex)
+            {
+                // 整字节：两次半字节查表
+                u8 bits = src[col >> 3];
+                const u16 *hi = fb->lut[bits >> 4];
+                const u16 *lo = fb->lut[bits & 0x0F];
+                u16 *d = dst + fill;
+                d[0] = hi[0];
+                d[1] = hi[1];
+                d[2] = hi[2];
+                d[3] = hi[3];
+                d[4] = lo[0];
+                d[5] = lo[1];
+                d[6] = lo[2];
+                d[7] = lo[3];
+                fill += 8;
+                col += 8;
+            }
+            else
+            {
+                // 非对齐的首尾像素逐位展开
+                u8 bit = (src[col >> 3] >> (7 - (col & 7))) & 1;
+                dst[fill++] = fb->lut[bit ? 0x0F : 0x00][0];
+                col++;
+            }
+        }
+    }
+
+    if (fill > 0)
+        LCD_SpiSend(lcd, lcd->batch, fill * 2);
+    LCD_PROF_LEAVE(lcd);
+}
+
+/**
+ * @brief 刷新整个单色帧缓冲到屏幕
+ * @param lcd LCD实例
+ * @param fb 帧缓冲对象
+ * @param x 画布左上角在屏幕上的X坐标
+ * @param y 画布左上角在屏幕上的Y坐标
+ */
+void LCDx_MonoFB_Flush(lcd_st7789_t *lcd, const lcd_mono_fb_t *fb, u16 x, u16 y)
+{
+    LCD_GateReady(lcd);
+    LCDx_MonoFB_FlushArea(lcd, fb, x, y, 0, 0, fb->width - 1, fb->height - 1);
+}
+
+/**
+ * @brief 发送按发送字节序存放的像素区域
+ * @param lcd LCD实例
+ * @param x 屏幕X坐标
+ * @param y 屏幕Y坐标
+ * @param w 宽度
+ * @param h 高度
+ * @param src 像素数据(按发送字节序存放)
+ * @param stride 源数据每行像素数
+ *
+ * 功能说明：
+ * 1. 超出屏幕右侧/下方的部分被裁剪
+ * 2. 各行在内存中连续(stride等于宽度)时直接从源数据发送，不经过batch_buffer
+ * 3. 否则逐行拷贝到batch_buffer，缓冲区满即发送
+ */
+static void LCD_SendWireRect(lcd_st7789_t *lcd, u16 x, u16 y, u16 w, u16 h, const u16 *src, u16 stride)
+{
+    u32 batch_size = LCD_BATCH_BUFFER_SIZE / 2; // 每批次像素数
+    u32 n = 0, left, c;
+    const u16 *row;
+    u16 r;
+
+    if (x >= lcd->dev->width || y >= lcd->dev->height || w == 0 || h == 0)
+        return;
+    if (w > lcd->dev->width - x)
+        w = lcd->dev->width - x;
+    if (h > lcd->dev->height - y)
+        h = lcd->dev->height - y;
+
+    LCD_SetWindows(lcd, x, y, w, h);
+    LCD_WriteRAM_Prepare(lcd);
+    LCD_DC_HIGH(lcd);
+
+    if (w == stride)
+    {
+        const u8 *p = (const u8 *)src;
+
+        left = (u32)w * h * 2;
+        while (left)
+        {
+            c = (left < LCD_BATCH_BUFFER_SIZE) ? left : LCD_BATCH_BUFFER_SIZE;
+            LCD_SpiSend(lcd, p, c);
+            p += c;
+            left -= c;
+        }
+        return;
+    }
+
+    for (r = 0; r < h; r++, src += stride)
+    {
+        row = src;
+        left = w;
+        while (left)
+        {
+            c = (left < batch_size - n) ? left : batch_size - n;
+            rt_memcpy(lcd->batch + n * 2, row, c * 2);
+            row += c;
+            left -= c;
+            n += c;
+            if (n == batch_size)
+            {
+                LCD_SpiSend(lcd, lcd->batch, n * 2);
+                n = 0;
+            }
+        }
+    }
+    if (n)
+        LCD_SpiSend(lcd, lcd->batch, n * 2);
+}
+
+/**
+ * @brief 初始化RGB565帧缓冲
+ * @param fb 帧缓冲对象
+ * @param width 画布宽度
+ * @param height 画布高度
+ * @param buf 像素缓冲区(width*height个u16)，RT_NULL时自动申请
+ * @return RT_EOK成功，-RT_EINVAL参数错误，-RT_ENOMEM内存不足
+ *
+ * 功能说明：
+ * 1. 像素按发送字节序存放，刷新时整行直接发送，画布全宽刷新时不经过batch_buffer
+ * 2. 初始化为全黑
+ */
+rt_err_t LCD_RgbFB_Init(lcd_rgb_fb_t *fb, u16 width, u16 height, u16 *buf)
+{
+    if (fb == RT_NULL || width == 0 || height == 0)
+        return -RT_EINVAL;
+
+    fb->width = width;
+    fb->height = height;
+    fb->buf = buf;
+    fb->owned = 0;
+
+    if (fb->buf == RT_NULL)
+    {
+        fb->buf = rt_malloc((rt_size_t)width * height * 2);
+        if (fb->buf == RT_NULL)
+        {
+            LOG_E("No memory for RGB565 framebuffer!");
+            return -RT_ENOMEM;
+        }
+        fb->owned = 1;
+    }
+
+    rt_memset(fb->buf, 0, (rt_size_t)width * height * 2);
+
+    return RT_EOK;
+}
+
+/**
+ * @brief 释放RGB565帧缓冲
+ * @param fb 帧缓冲对象
+ *
+ * 功能说明：只释放由LCD_RgbFB_Init自动申请的缓冲区
+ */
+void LCD_RgbFB_Deinit(lcd_rgb_fb_t *fb)
+{
+    if (fb->owned)
+        rt_free(fb->buf);
+    fb->buf = RT_NULL;
+    fb->owned = 0;
+}
+
+/**
+ * @brief 在RGB565帧缓冲中画点
+ * @param fb 帧缓冲对象
+ * @param x X坐标
+ * @param y Y坐标
+ * @param color 颜色(RGB565)
+ */
+void LCD_RgbFB_DrawPoint(lcd_rgb_fb_t *fb, u16 x, u16 y, u16 color)
+{
+    if (x >= fb->width || y >= fb->height)
+        return;
+
+    fb->buf[(u32)y * fb->width + x] = LCD_TO_WIRE16(color);
+}
+
+/**
+ * @brief 在RGB565帧缓冲中填充矩形
+ * @param fb 帧缓冲对象
+ * @param sx 起始X坐标
+ * @param sy 起始Y坐标
+ * @param ex 结束X坐标
+ * @param ey 结束Y坐标
+ * @param color 颜色(RGB565)
+ *
+ * 功能说明：超出画布的部分被裁剪；首行逐像素填充，其余行从首行整行拷贝
+ */
+void LCD_RgbFB_Fill(lcd_rgb_fb_t *fb, u16 sx, u16 sy, u16 ex, u16 ey, u16 color)
+{
+    u16 c = LCD_TO_WIRE16(color);
+    u16 *first, *row;
+    u16 x, y, w;
+
+    if (sx >= fb->width || sy >= fb->height || sx > ex || sy > ey)
+        return;
+    if (ex >= fb->width)
+        ex = fb->width - 1;
+    if (ey >= fb->height)
+        ey = fb->height - 1;
+    w = ex - sx + 1;
+
+    first = &fb->buf[(u32)sy * fb->width + sx];
+    for (x = 0; x < w; x++)
+        first[x] = c;
+
+    row = first;
+    for (y = sy + 1; y <= ey; y++)
+    {
+        row += fb->width;
+        rt_memcpy(row, first, (rt_size_t)w * 2);
+    }
+}
+
+/**
+ * @brief 清空RGB565帧缓冲
+ * @param fb 帧缓冲对象
+ * @param color 颜色(RGB565)
+ */
+void LCD_RgbFB_Clear(lcd_rgb_fb_t *fb, u16 color)
+{
+    LCD_RgbFB_Fill(fb, 0, 0, fb->width - 1, fb->height - 1, color);
+}
+
+/**
+ * @brief 刷新RGB565帧缓冲的一个区域到屏幕
+ * @param lcd LCD实例
+ * @param fb 帧缓冲对象
+ * @param x 画布原点在屏幕上的X坐标
+ * @param y 画布原点在屏幕上的Y坐标
+ * @param sx 画布区域起始X
+ * @param sy 画布区域起始Y
+ * @param ex 画布区域结束X
+ * @param ey 画布区域结束Y
+ *
+ * 功能说明：
+ * 1. 设置一次窗口，像素已是发送字节序，无需逐像素转换
+ * 2. 区域与画布同宽时直接从帧缓冲发送，否则逐行拷贝到batch_buffer
+ */
+void LCDx_RgbFB_FlushArea(lcd_st7789_t *lcd, const lcd_rgb_fb_t *fb, u16 x, u16 y, u16 sx, u16 sy, u16 ex, u16 ey)
+{
+    LCD_GateReady(lcd);
+    if (sx >= fb->width || sy >= fb->height || sx > ex || sy > ey)
+        return;
+    if (ex >= fb->width)
+        ex = fb->width - 1;
+    if (ey >= fb->height)
+        ey = fb->height - 1;
+
+    LCD_PROF_ENTER(lcd, LCD_STAT_FB_FLUSH);
+    LCD_SendWireRect(lcd, x + sx, y + sy, ex - sx + 1, ey - sy + 1, &fb->buf[(u32)sy * fb->width + sx], fb->width);
+    LCD_PROF_LEAVE(lcd);
+}
+
+/**
+ * @brief 刷新整个RGB565帧缓冲到屏幕
+ * @param lcd LCD实例
+ * @param fb 帧缓冲对象
+ * @param x 画布左上角在屏幕上的X坐标
+ * @param y 画布左上角在屏幕上的Y坐标
+ */
+void LCDx_RgbFB_Flush(lcd_st7789_t *lcd, const lcd_rgb_fb_t *fb, u16 x, u16 y)
+{
+    LCD_GateReady(lcd);
+    LCDx_RgbFB_FlushArea(lcd, fb, x, y, 0, 0, fb->width - 1, fb->height - 1);
+}
+
+/**
+ * @brief 区域刷屏(像素已按发送字节序存放)
+ * @param lcd LCD实例
+ * @param x1 左上角起始X坐标
+ * @param y1 左上角起始Y坐标
+ * @param x2 右下角结束X坐标
+ * @param y2 右下角结束Y坐标
+ * @param pData 像素数据(RGB565，高字节在前，如LVGL开启LV_COLOR_16_SWAP时的绘制缓冲区)
+ *
+ * 功能说明：
+ * 1. 设置窗口后直接从pData发送，不做字节序转换也不经过batch_buffer
+ * 2. 不使用RGB444批量格式，始终以RGB565传输
+ */
+void LCDx_DispFlushWire(lcd_st7789_t *lcd, u16 x1, u16 y1, u16 x2, u16 y2, const void *pData)
+{
+    LCD_GateReady(lcd);
+    if (x2 < x1 || y2 < y1)
+        return;
+
+    LCD_PROF_ENTER(lcd, LCD_STAT_FLUSH);
+    LCD_SendWireRect(lcd, x1, y1, x2 - x1 + 1, y2 - y1 + 1, (const u16 *)pData, x2 - x1 + 1);
+    LCD_PROF_LEAVE(lcd);
+}
+
+/**
+ * @brief 扫描一行中的不透明段
+ * @param row 行像素
+ * @param width 行宽
+ * @param key 透明色
+ * @param x 起始扫描位置，返回段起点
+ * @return 段长度，0表示该行已无不透明段
+ */
+static u16 LCD_SpriteNextRun(const u16 *row, u16 width, u16 key, u16 *x)
+{
+    u16 s = *x, e;
+
+    while (s < width && row[s] == key)
+        s++;
+    e = s;
+    while (e < width && row[e] != key)
+        e++;
+
+    *x = s;
+    return e - s;
+}
+
+/**
+ * @brief 由带透明色的图片生成精灵
+ * @param spr 精灵对象
+ * @param img 源图(RGB565，行优先)
+ * @param width 图片宽度
+ * @param height 图片高度
+ * @param key 透明色，等于该颜色的像素不绘制
+ * @return RT_EOK成功，-RT_EINVAL参数错误，-RT_ENOMEM内存不足
+ *
+ * 功能说明：
+ * 1. 逐行把不透明像素分为连续段，上下相邻且起点、长度相同的段合并为一个矩形
+ * 2. 矩形表与按发送字节序排列的不透明像素保存在一块内存中，源图之后不再使用
+ * 3. 绘制时每个矩形一次窗口、一次发送，透明部分不占用总线
+ * 4. 生成期间临时申请按段数计的工作表，完成后释放
+ */
+rt_err_t LCD_Sprite_Init(lcd_sprite_t *spr, const u16 *img, u16 width, u16 height, u16 key)
+{
+    lcd_sprite_rect_t *tmp, *r;
+    u32 runs = 0, pixels = 0, i;
+    u16 count = 0, x, y, len;
+    u16 *dst;
+    const u16 *src;
+
+    if (spr == RT_NULL || img == RT_NULL || width == 0 || height == 0)
+        return -RT_EINVAL;
+
+    spr->width = width;
+    spr->height = height;
+    spr->count = 0;
+    spr->rects = RT_NULL;
+
+    // 第一遍：统计段数与不透明像素数
+    for (y = 0; y < height; y++)
+    {
+        for (x = 0; (len = LCD_SpriteNextRun(img + (u32)y * width, width, key, &x)) != 0; x += len)
+        {
+            runs++;
+            pixels += len;
+        }
+    }
+    if (runs == 0)
+        return RT_EOK;
+    if (runs > 0xFFFF)
+        return -RT_EINVAL;
+
+    tmp = (lcd_sprite_rect_t *)rt_malloc(runs * sizeof(lcd_sprite_rect_t));
+    if (tmp == RT_NULL)
+        return -RT_ENOMEM;
+
+    // 第二遍：与上一行结束的同位置矩形合并
+    for (y = 0; y < height; y++)
+    {
+        for (x = 0; (len = LCD_SpriteNextRun(img + (u32)y * width, width, key, &x)) != 0; x += len)
+        {
+            for (i = 0; i < count; i++)
+            {
+                if (tmp[i].x == x && tmp[i].w == len && tmp[i].y + tmp[i].h == y)
+                    break;
+            }
+            if (i < count)
+            {
+                tmp[i].h++;
+                continue;
+            }
+            tmp[count].x = x;
+            tmp[count].y = y;
+            tmp[count].w = len;
+            tmp[count].h = 1;
+            count++;
+        }
+    }
+
+    spr->rects = (lcd_sprite_rect_t *)rt_malloc(count * sizeof(lcd_sprite_rect_t) + pixels * 2);
+    if (spr->rects == RT_NULL)
+    {
+        rt_free(tmp);
+        LOG_E("No memory for sprite!");
+        return -RT_ENOMEM;
+    }
+    rt_memcpy(spr->rects, tmp, count * sizeof(lcd_sprite_rect_t));
+    rt_free(tmp);
+    spr->count = count;
+
+    // 各矩形的像素依次存放在矩形表之后
+    dst = (u16 *)(spr->rects + count);
+    for (i = 0; i < count; i++)
+    {
+        r = &spr->rects[i];
+        for (y = 0; y < r->h; y++)
+        {
+            src = img + (u32)(r->y + y) * width + r->x;
+            for (x = 0; x < r->w; x++)
+                *dst++ = LCD_TO_WIRE16(src[x]);
+        }
+    }
+
+    return RT_EOK;
+}
+
+/**
+ * @brief 释放精灵
+ * @param spr 精灵对象
+ */
+void LCD_Sprite_Deinit(lcd_sprite_t *spr)
+{
+    rt_free(spr->rects);
+    spr->rects = RT_NULL;
+    spr->count = 0;
+}
+
+/**
+ * @brief 在屏幕上绘制精灵
+ * @param lcd LCD实例
+ * @param spr 精灵对象
+ * @param x 精灵左上角X坐标
+ * @param y 精灵左上角Y坐标
+ *
+ * 功能说明：
+ * 1. 只发送不透明矩形，透明像素处保留屏幕原有内容
+ * 2. 完全在屏幕内的矩形直接从精灵数据发送，超出屏幕右侧/下方的部分被裁剪
+ * 3. 始终以RGB565发送，不受LCD_SetBulkFormat影响
+ */
+void LCDx_Sprite_Draw(lcd_st7789_t *lcd, const lcd_sprite_t *spr, u16 x, u16 y)
+{
+    const u16 *data = (const u16 *)(spr->rects + spr->count);
+    const lcd_sprite_rect_t *r;
+    u32 rx, ry;
+    u16 i;
+
+    LCD_GateReady(lcd);
+    LCD_PROF_ENTER(lcd, LCD_STAT_SPRITE);
+    for (i = 0; i < spr->count; i++)
+    {
+        r = &spr->rects[i];
+        rx = (u32)x + r->x;
+        ry = (u32)y + r->y;
+        if (rx < lcd->dev->width && ry < lcd->dev->height)
+            LCD_SendWireRect(lcd, rx, ry, r->w, r->h, data, r->w);
+        data += (u32)r->w * r->h;
+    }
+    LCD_PROF_LEAVE(lcd);
+}
+
+/**
+ * @brief 把精灵合成到RGB565帧缓冲
+ * @param fb 帧缓冲对象
+ * @param spr 精灵对象
+ * @param x 精灵左上角在画布中的X坐标
+ * @param y 精灵左上角在画布中的Y坐标
+ *
+ * 功能说明：按矩形逐行整段拷贝，透明像素处保留画布内容，超出画布的部分被裁剪
+ */
+void LCD_RgbFB_DrawSprite(lcd_rgb_fb_t *fb, const lcd_sprite_t *spr, u16 x, u16 y)
+{
+    const u16 *data = (const u16 *)(spr->rects + spr->count);
+    const lcd_sprite_rect_t *r;
+    u32 rx, ry;
+    u16 i, row, w, h;
+
+    for (i = 0; i < spr->count; i++)
+    {
+        r = &spr->rects[i];
+        rx = (u32)x + r->x;
+        ry = (u32)y + r->y;
+        if (rx < fb->width && ry < fb->height)
+        {
+            w = (r->w < fb->width - rx) ? r->w : fb->width - rx;
+            h = (r->h < fb->height - ry) ? r->h : fb->height - ry;
+            for (row = 0; row < h; row++)
+                rt_memcpy(&fb->buf[(ry + row) * fb->width + rx], data + (u32)row * r->w, (rt_size_t)w * 2);
+        }
+        data += (u32)r->w * r->h;
+    }
+}
+
+/**
+ * @brief 把RGB565展开为32位(绿色移到高16位，红/蓝留在低16位)
+ * @param c 颜色(RGB565)
+ * @return 展开后的值，各分量之间留有5位空隙
+ */
+rt_inline u32 LCD_Spread565(u16 c)
+{
+    return (c | ((u32)c << 16)) & 0x07E0F81F;
+}
+
+/**
+ * @brief 以5位透明度混合两个RGB565颜色
+ * @param fg 前景色(RGB565)
+ * @param bg 已展开的背景色(LCD_Spread565)
+ * @param a 前景权重0~32
+ * @return 混合结果(RGB565)
+ *
+ * 功能说明：三个分量在一个32位字中同时乘加，每像素一次乘法代替三次
+ */
+rt_inline u16 LCD_Blend565(u16 fg, u32 bg, u8 a)
+{
+    u32 c = ((LCD_Spread565(fg) * a + bg * (32 - a)) >> 5) & 0x07E0F81F;
+
+    return (u16)(c | (c >> 16));
+}
+
+/**
+ * @brief 混合带透明度图片的一段像素
+ * @param img 图片
+ * @param pos 段起点在图片中的像素序号
+ * @param n 像素数
+ * @param bg 背景像素(按发送字节序)，RT_NULL表示纯色背景
+ * @param bg_color 纯色背景(RGB565)
+ * @param lut A8格式纯色背景时的33级结果表(按发送字节序)，其余情况为RT_NULL
+ * @param out 输出(按发送字节序)，可与bg相同
+ *
+ * 功能说明：
+ * 1. 透明度量化为5位(0~32)，完全透明/不透明的像素不做乘法
+ * 2. A8格式在纯色背景上前景、背景都不变，直接查表
+ */
+static void LCD_AlphaSpan(const lcd_alpha_img_t *img, u32 pos, u32 n, const u16 *bg, u16 bg_color,
+                          const u16 *lut, u16 *out)
+{
+    u32 bs = LCD_Spread565(bg_color);
+    u32 i, argb;
+    const u8 *alpha;
+    u16 fg, c;
+    u8 a;
+
+    if (img->format == LCD_ALPHA_ARGB8888)
+    {
+        const u32 *src = (const u32 *)img->data + pos;
+
+        for (i = 0; i < n; i++)
+        {
+            argb = src[i];
+            a = (u8)(((argb >> 24) + 4) >> 3);
+            fg = (u16)(((argb >> 8) & 0xF800) | ((argb >> 5) & 0x07E0) | ((argb >> 3) & 0x001F));
+            if (bg != RT_NULL)
+            {
+                c = bg[i];
+                bs = LCD_Spread565(LCD_TO_WIRE16(c)); // 字节交换两次即还原
+            }
+            fg = (a == 32) ? fg : LCD_Blend565(fg, bs, a);
+            out[i] = LCD_TO_WIRE16(fg);
+        }
+        return;
+    }
+
+    if (img->format == LCD_ALPHA_A8)
+    {
+        alpha = (const u8 *)img->data + pos;
+        if (lut != RT_NULL)
+        {
+            for (i = 0; i < n; i++)
+                out[i] = lut[(alpha[i] + 4) >> 3];
+            return;
+        }
+    }
+    else
+    {
+        alpha = (const u8 *)((const u16 *)img->data + (u32)img->width * img->height) + pos;
+    }
+
+    for (i = 0; i < n; i++)
+    {
+        a = (u8)((alpha[i] + 4) >> 3);
+        if (a == 0)
+        {
+            if (bg == RT_NULL)
+                out[i] = LCD_TO_WIRE16(bg_color);
+            continue;
+        }
+        fg = (img->format == LCD_ALPHA_A8) ? img->color : ((const u16 *)img->data)[pos + i];
+        if (a < 32)
+        {
+            if (bg != RT_NULL)
+            {
+                c = bg[i];
+                bs = LCD_Spread565(LCD_TO_WIRE16(c));
+            }
+            fg = LCD_Blend565(fg, bs, a);
+        }
+        out[i] = LCD_TO_WIRE16(fg);
+    }
+}
+
+/**
+ * @brief 在纯色背景上显示带透明度的图片
+ * @param lcd LCD实例
+ * @param x 图片左上角X坐标
+ * @param y 图片左上角Y坐标
+ * @param img 图片(ARGB8888/RGB565A8/A8)
+ * @param bg_color 背景颜色
+ *
+ * 功能说明：
+ * 1. 适用于已知底色的图标、抗锯齿字形与阴影，不需要回读屏幕
+ * 2. 整个图片只设置一次窗口，逐行混合后直接写入批量缓冲区，缓冲区满即发送
+ * 3. A8格式先算出33级混合结果表，每像素只查表
+ * 4. 超出屏幕右侧/下方的部分自动裁剪
+ */
+void LCDx_ShowAlphaImage(lcd_st7789_t *lcd, u16 x, u16 y, const lcd_alpha_img_t *img, u16 bg_color)
+{
+    u16 *wire = (u16 *)lcd->batch;
+    u32 batch_size = LCD_BATCH_BUFFER_SIZE / 2; // 每批次像素数
+    u32 n = 0, pos, left, c;
+    u16 lut[33];
+    u16 w, h, r;
+    u8 a;
+
+    LCD_GateReady(lcd);
+    if (x >= lcd->dev->width || y >= lcd->dev->height || img->width == 0 || img->height == 0)
+        return;
+    w = (img->width < lcd->dev->width - x) ? img->width : lcd->dev->width - x;
+    h = (img->height < lcd->dev->height - y) ? img->height : lcd->dev->height - y;
+
+    if (img->format == LCD_ALPHA_A8)
+    {
+        for (a = 0; a <= 32; a++)
+            lut[a] = LCD_TO_WIRE16(LCD_Blend565(img->color, LCD_Spread565(bg_color), a));
+    }
+
+    LCD_PROF_ENTER(lcd, LCD_STAT_ALPHA);
+    LCD_SetWindows(lcd, x, y, w, h);
+    LCD_WriteRAM_Prepare(lcd);
+    LCD_DC_HIGH(lcd);
+
+    for (r = 0; r < h; r++)
+    {
+        pos = (u32)r * img->width;
+        left = w;
+        while (left)
+        {
+            c = (left < batch_size - n) ? left : batch_size - n;
+            LCD_AlphaSpan(img, pos, c, RT_NULL, bg_color, (img->format == LCD_ALPHA_A8) ? lut : RT_NULL, wire + n);
+            pos += c;
+            left -= c;
+            n += c;
+            if (n == batch_size)
+            {
+                LCD_SpiSend(lcd, lcd->batch, n * 2);
+                n = 0;
+            }
+        }
+    }
+    if (n)
+        LCD_SpiSend(lcd, lcd->batch, n * 2);
+    LCD_PROF_LEAVE(lcd);
+}
+
+/**
+ * @brief 把带透明度的图片混合到RGB565帧缓冲
+ * @param fb 帧缓冲对象
+ * @param x 图片左上角在画布中的X坐标
+ * @param y 图片左上角在画布中的Y坐标
+ * @param img 图片(ARGB8888/RGB565A8/A8)
+ *
+ * 功能说明：逐像素与画布原有内容混合，结果写回画布，超出画布的部分被裁剪
+ */
+void LCD_RgbFB_DrawAlphaImage(lcd_rgb_fb_t *fb, u16 x, u16 y, const lcd_alpha_img_t *img)
+{
+    u16 *row;
+    u16 w, h, r;
+
+    if (x >= fb->width || y >= fb->height || img->width == 0 || img->height == 0)
+        return;
+    w = (img->width < fb->width - x) ? img->width : fb->width - x;
+    h = (img->height < fb->height - y) ? img->height : fb->height - y;
+
+    for (r = 0; r < h; r++)
+    {
+        row = &fb->buf[(u32)(y + r) * fb->width + x];
+        LCD_AlphaSpan(img, (u32)r * img->width, w, row, 0, RT_NULL, row);
+    }
+}
+
+/**
+ * @brief 生成渐变颜色表
+ * @param lut 输出256项颜色(按发送字节序)
+ * @param c0 起点颜色
+ * @param c1 终点颜色
+ *
+ * 功能说明：R/G/B分量分别在c0与c1之间按8位定点线性插值并四舍五入
+ */
+static void LCD_GradientLut(u16 *lut, u16 c0, u16 c1)
+{
+    rt_int32_t r0 = c0 >> 11, g0 = (c0 >> 5) & 0x3F, b0 = c0 & 0x1F;
+    rt_int32_t dr = (rt_int32_t)(c1 >> 11) - r0, dg = (rt_int32_t)((c1 >> 5) & 0x3F) - g0, db = (rt_int32_t)(c1 & 0x1F) - b0;
+    rt_int32_t i;
+    u16 c;
+
+    for (i = 0; i < 256; i++)
+    {
+        c = (u16)(((r0 + (dr * i + (dr < 0 ? -127 : 127)) / 255) << 11) |
+                  ((g0 + (dg * i + (dg < 0 ? -127 : 127)) / 255) << 5) |
+                  (b0 + (db * i + (db < 0 ? -127 : 127)) / 255));
+        lut[i] = LCD_TO_WIRE16(c);
+    }
+}
+
+/**
+ * @brief 裁剪填充区域
+ * @param lcd LCD实例
+ * @param ex 结束X坐标(可能被改小)
+ * @param ey 结束Y坐标(可能被改小)
+ * @return 1区域有效，0区域为空
+ */
+static u8 LCD_ClipFill(lcd_st7789_t *lcd, u16 sx, u16 sy, u16 *ex, u16 *ey)
+{
+    if (sx >= lcd->dev->width || sy >= lcd->dev->height || *ex < sx || *ey < sy)
+        return 0;
+    if (*ex >= lcd->dev->width)
+        *ex = lcd->dev->width - 1;
+    if (*ey >= lcd->dev->height)
+        *ey = lcd->dev->height - 1;
+    return 1;
+}
+
+/**
+ * @brief 整数平方根(向下取整)
+ * @param v 被开方数
+ * @return floor(sqrt(v))
+ */
+static u32 LCD_Isqrt(u32 v)
+{
+    u32 r = 0, bit = 1UL << 30;
+
+    while (bit > v)
+        bit >>= 2;
+    while (bit)
+    {
+        if (v >= r + bit)
+        {
+            v -= r + bit;
+            r = (r >> 1) + bit;
+        }
+        else
+        {
+            r >>= 1;
+        }
+        bit >>= 2;
+    }
+    return r;
+}
+
+/**
+ * @brief 线性渐变填充
+ * @param lcd LCD实例
+ * @param sx 起始X坐标
+ * @param sy 起始Y坐标
+ * @param ex 结束X坐标
+ * @param ey 结束Y坐标
+ * @param x0 渐变起点X坐标
+ * @param y0 渐变起点Y坐标
+ * @param c0 起点颜色
+ * @param x1 渐变终点X坐标
+ * @param y1 渐变终点Y坐标
+ * @param c1 终点颜色
+ *
+ * 功能说明：
+ * 1. 颜色沿(x0,y0)→(x1,y1)方向变化，垂直于该方向的直线上颜色相同，两端以外保持端点颜色
+ * 2. 先生成256级颜色表，每像素只做一次12位定点加法和查表，不使用浮点
+ * 3. 整个区域只设置一次窗口，逐行写入批量缓冲区，缓冲区满即发送
+ * 4. 水平方向的渐变各行相同，只计算第一行
+ * 5. 超出屏幕的部分自动裁剪；起点与终点重合时整块填充c1
+ */
+void LCDx_FillLinearGradient(lcd_st7789_t *lcd, u16 sx, u16 sy, u16 ex, u16 ey,
+                             u16 x0, u16 y0, u16 c0, u16 x1, u16 y1, u16 c1)
+{
+    u16 *lut = (u16 *)(lcd->batch + LCD_BATCH_BUFFER_SIZE) - 256; // 颜色表放在批量缓冲区末尾
+    u16 *wire = (u16 *)lcd->batch;
+    rt_int32_t dx = (rt_int32_t)x1 - x0, dy = (rt_int32_t)y1 - y0;
+    rt_int64_t len2 = (rt_int64_t)dx * dx + (rt_int64_t)dy * dy;
+    rt_int64_t t;
+    rt_int32_t step_x, step_y, v, idx;
+    u32 rows, n;
+    u16 w, h, r, i;
+
+    LCD_GateReady(lcd);
+    if (!LCD_ClipFill(lcd, sx, sy, &ex, &ey))
+        return;
+    if (len2 == 0)
+    {
+        LCDx_Fill(lcd, sx, sy, ex, ey, c1);
+        return;
+    }
+    w = ex - sx + 1;
+    h = ey - sy + 1;
+    rows = (LCD_BATCH_BUFFER_SIZE / 2 - 256) / w; // 每批次行数
+
+    LCD_PROF_ENTER(lcd, LCD_STAT_GRADIENT);
+    LCD_GradientLut(lut, c0, c1);
+
+    // 每移动一个像素，颜色表位置变化dx*255/len2(12位小数)
+    step_x = (rt_int32_t)(((rt_int64_t)dx * (255 << 12)) / len2);
+    step_y = (rt_int32_t)(((rt_int64_t)dy * (255 << 12)) / len2);
+
+    LCD_SetWindows(lcd, sx, sy, w, h);
+    LCD_WriteRAM_Prepare(lcd);
+    LCD_DC_HIGH(lcd);
+
+    n = 0;
+    for (r = 0; r < h; r++)
+    {
+        if (r > 0 && step_y == 0)
+        {
+            if (n) // n为0时第0行仍是上一批次的内容
+                rt_memcpy(wire + n * w, wire, w * 2);
+        }
+        else
+        {
+            // 每行起点单独计算，误差不随行数累积；限幅保证行内累加不溢出
+            t = (((rt_int64_t)sx - x0) * dx + ((rt_int64_t)(sy + r) - y0) * dy) * (255 << 12) / len2;
+            if (t > ((rt_int64_t)1 << 29))
+                t = (rt_int64_t)1 << 29;
+            else if (t < -((rt_int64_t)1 << 29))
+                t = -((rt_int64_t)1 << 29);
+            v = (rt_int32_t)t + (1 << 11);
+            for (i = 0; i < w; i++)
+            {
+                idx = v >> 12;
+                wire[n * w + i] = lut[idx < 0 ? 0 : (idx > 255 ? 255 : idx)];
+                v += step_x;
+            }
+        }
+        if (++n == rows)
+        {
+            LCD_SpiSend(lcd, lcd->batch, n * w * 2);
+            n = 0;
+        }
+    }
+    if (n)
+        LCD_SpiSend(lcd, lcd->batch, n * w * 2);
+    LCD_PROF_LEAVE(lcd);
+}
+
+/**
+ * @brief 径向渐变填充
+ * @param lcd LCD实例
+ * @param sx 起始X坐标
+ * @param sy 起始Y坐标
+ * @param ex 结束X坐标
+ * @param ey 结束Y坐标
+ * @param cx 圆心X坐标
+ * @param cy 圆心Y坐标
+ * @param r 半径
+ * @param c0 圆心颜色
+ * @param c1 半径处及以外的颜色
+ *
+ * 功能说明：
+ * 1. 颜色随到圆心的距离从c0变化到c1，不使用浮点和逐像素开方
+ * 2. 距离平方按差分逐像素累加，颜色表位置在相邻像素间增减调整，每行只开方一次
+ * 3. 整个区域只设置一次窗口，逐行写入批量缓冲区，缓冲区满即发送
+ * 4. 超出屏幕的部分自动裁剪；半径为0时整块填充c1
+ */
+void LCDx_FillRadialGradient(lcd_st7789_t *lcd, u16 sx, u16 sy, u16 ex, u16 ey,
+                             u16 cx, u16 cy, u16 r, u16 c0, u16 c1)
+{
+    u16 *lut = (u16 *)(lcd->batch + LCD_BATCH_BUFFER_SIZE) - 256; // 颜色表放在批量缓冲区末尾
+    u16 *wire = (u16 *)lcd->batch;
+    u32 r2 = (u32)r * r;
+    u32 inv, d2, q, idx, rows, n;
+    rt_int32_t ddx, ddy;
+    u16 w, h, row, i;
+
+    LCD_GateReady(lcd);
+    if (!LCD_ClipFill(lcd, sx, sy, &ex, &ey))
+        return;
+    if (r == 0)
+    {
+        LCDx_Fill(lcd, sx, sy, ex, ey, c1);
+        return;
+    }
+    w = ex - sx + 1;
+    h = ey - sy + 1;
+    rows = (LCD_BATCH_BUFFER_SIZE / 2 - 256) / w; // 每批次行数
+    inv = (65025UL << 12) / r2;                   // idx^2 = d2*255^2/r2，q为其12位定点值
+
+    LCD_PROF_ENTER(lcd, LCD_STAT_GRADIENT);
+    LCD_GradientLut(lut, c0, c1);
+
+    LCD_SetWindows(lcd, sx, sy, w, h);
+    LCD_WriteRAM_Prepare(lcd);
+    LCD_DC_HIGH(lcd);
+
+    n = 0;
+    idx = 0;
+    for (row = 0; row < h; row++)
+    {
+        ddx = (rt_int32_t)sx - cx;
+        ddy = (rt_int32_t)(sy + row) - cy;
+        d2 = (u32)(ddx * ddx) + (u32)(ddy * ddy);
+        if (d2 < r2)
+            idx = LCD_Isqrt((d2 * inv) >> 12);
+        for (i = 0; i < w; i++)
+        {
+            if (d2 >= r2)
+            {
+                wire[n * w + i] = lut[255];
+                idx = 255;
+            }
+            else
+            {
+                // 相邻像素的距离变化很小，idx通常只需调整0~1次
+                q = d2 * inv;
+                while (idx < 255 && ((idx + 1) * (idx + 1) << 12) <= q)
+                    idx++;
+                while (idx > 0 && (idx * idx << 12) > q)
+                    idx--;
+                wire[n * w + i] = lut[idx];
+            }
+            d2 += 2 * ddx + 1; // (x+1)^2 = x^2 + 2x + 1
+            ddx++;
+        }
+        if (++n == rows)
+        {
+            LCD_SpiSend(lcd, lcd->batch, n * w * 2);
+            n = 0;
+        }
+    }
+    if (n)
+        LCD_SpiSend(lcd, lcd->batch, n * w * 2);
+    LCD_PROF_LEAVE(lcd);
+}
+
+/**
+ * @brief 图案平铺填充
+ * @param lcd LCD实例
+ * @param sx 起始X坐标
+ * @param sy 起始Y坐标
+ * @param ex 结束X坐标
+ * @param ey 结束Y坐标
+ * @param tile 图案数据(RGB565，行优先)
+ * @param tw 图案宽度
+ * @param th 图案高度
+ *
+ * 功能说明：
+ * 1. 图案以屏幕原点对齐平铺，相邻区域分别填充时图案连续
+ * 2. 每行只转换一个图案周期的像素，其余部分按倍增方式复制
+ * 3. 整个区域只设置一次窗口，逐行写入批量缓冲区，缓冲区满即发送
+ * 4. 超出屏幕的部分自动裁剪
+ */
+void LCDx_FillPattern(lcd_st7789_t *lcd, u16 sx, u16 sy, u16 ex, u16 ey, const u16 *tile, u16 tw, u16 th)
+{
+    u16 *wire = (u16 *)lcd->batch;
+    u16 *dst;
+    const u16 *src;
+    u32 rows, n, done, chunk;
+    u16 w, h, r, i, u, period, color;
+
+    LCD_GateReady(lcd);
+    if (tile == RT_NULL || tw == 0 || th == 0 || !LCD_ClipFill(lcd, sx, sy, &ex, &ey))
+        return;
+    w = ex - sx + 1;
+    h = ey - sy + 1;
+    rows = (LCD_BATCH_BUFFER_SIZE / 2) / w; // 每批次行数
+    period = (tw < w) ? tw : w;
+
+    LCD_PROF_ENTER(lcd, LCD_STAT_PATTERN);
+    LCD_SetWindows(lcd, sx, sy, w, h);
+    LCD_WriteRAM_Prepare(lcd);
+    LCD_DC_HIGH(lcd);
+
+    n = 0;
+    for (r = 0; r < h; r++)
+    {
+        dst = wire + n * w;
+        src = tile + (u32)((sy + r) % th) * tw;
+        u = sx % tw;
+        for (i = 0; i < period; i++)
+        {
+            color = src[u];
+            dst[i] = LCD_TO_WIRE16(color);
+            if (++u == tw)
+                u = 0;
+        }
+        // 已生成的部分是周期的整数倍，整体复制后仍保持连续
+        for (done = period; done < w; done += chunk)
+        {
+            chunk = (done < w - done) ? done : w - done;
+            rt_memcpy(dst + done, dst, chunk * 2);
+        }
+        if (++n == rows)
+        {
+            LCD_SpiSend(lcd, lcd->batch, n * w * 2);
+            n = 0;
+        }
+    }
+    if (n)
+        LCD_SpiSend(lcd, lcd->batch, n * w * 2);
+    LCD_PROF_LEAVE(lcd);
+}
+
+/**
+ * @brief 读取保存的SPI时钟
+ * @return 保存的时钟(Hz)，0表示未保存
+ *
+ * 功能说明：弱函数，默认不持久化；可在板级代码中用FAL/EasyFlash等重写
+ */
+RT_WEAK rt_uint32_t LCD_SPI_LoadHz(void)
+{
+    return 0;
+}
+
+/**
+ * @brief 保存SPI时钟校准结果
+ * @param hz 校准得到的时钟(Hz)
+ *
+ * 功能说明：弱函数，默认不持久化；重写后spi_lcd_init启动时会通过LCD_SPI_LoadHz读回
+ */
+RT_WEAK void LCD_SPI_SaveHz(rt_uint32_t hz)
+{
+    (void)hz;
+}
+
+/**
+ * @brief 获取当前SPI写时钟
+ * @param lcd LCD实例
+ * @return 时钟(Hz)
+ */
+rt_uint32_t LCDx_SPI_GetHz(lcd_st7789_t *lcd)
+{
+    LCD_GateReady(lcd);
+    return lcd->spi_hz;
+}
+
+#ifdef PKG_ST7789_USING_READ
+#define LCD_TUNE_W 64     // 校准图案宽度
+#define LCD_TUNE_H 4      // 校准图案高度
+#define LCD_TUNE_ROUNDS 3 // 每个频率写入/校验的图案数
+
+/**
+ * @brief 生成校准图案像素
+ * @param i 像素序号
+ * @param round 图案轮次
+ * @return RGB565颜色
+ *
+ * 功能说明：交替0x5555/0xAAAA与伪随机值，覆盖连续翻转与随机位组合
+ */
+static u16 LCD_TunePattern(u32 i, u8 round)
+{
+    if (round == 0)
+        return (i & 1) ? 0xAAAA : 0x5555;
+    return (u16)((i * 40503u + round * 0x9E37u) >> 3);
+}
+
+/**
+ * @brief 在当前SPI时钟下写入并回读校验图案
+ * @param lcd LCD实例
+ * @param round 图案轮次
+ * @return 错误像素数
+ *
+ * 功能说明：
+ * 1. 以待测时钟写入图案
+ * 2. 以安全读时钟RAMRD回读(每像素3字节RGB666)
+ * 3. 只比较RGB565有效位
+ */
+static u32 LCD_TuneVerify(lcd_st7789_t *lcd, u8 round)
+{
+    uint8_t *tx = lcd->batch + LCD_BATCH_BUFFER_SIZE / 2; // 后半缓冲区放图案，前半接收回读
+    u32 i, errors = 0;
+
+    for (i = 0; i < LCD_TUNE_W * LCD_TUNE_H; i++)
+    {
+        u16 c = LCD_TunePattern(i, round);
+        tx[i * 2] = c >> 8;
+        tx[i * 2 + 1] = c & 0xFF;
+    }
+
+    LCD_SetWindows(lcd, 0, 0, LCD_TUNE_W, LCD_TUNE_H);
+    LCD_WriteRAM_Prepare(lcd);
+    LCD_DC_HIGH(lcd);
+    LCD_SpiSend(lcd, tx, LCD_TUNE_W * LCD_TUNE_H * 2);
+
+    LCD_SetWindows(lcd, 0, 0, LCD_TUNE_W, LCD_TUNE_H);
+    LCD_ReadData(lcd, 0x2E, lcd->batch, LCD_TUNE_W * LCD_TUNE_H * 3, 8);
+
+    for (i = 0; i < LCD_TUNE_W * LCD_TUNE_H; i++)
+    {
+        const uint8_t *px = &lcd->batch[i * 3];
+        u16 c = ((px[0] & 0xF8) << 8) | ((px[1] & 0xFC) << 3) | (px[2] >> 3);
+        if (c != LCD_TunePattern(i, round))
+            errors++;
+    }
+
+    return errors;
+}
+#endif
+
+/**
+ * @brief 回读校验自动校准SPI时钟
+ * @param lcd LCD实例
+ * @param min_hz 起始(最低)时钟
+ * @param max_hz 最高尝试时钟
+ * @param step_hz 步进
+ * @param result_hz 输出校准结果，可为RT_NULL
+ * @return RT_EOK成功，-RT_ENOSYS未开启回读或面板无应答，-RT_EIO最低时钟即出错
+ *
+ * 功能说明：
+ * 1. 先以读时钟RDDID(0x04)确认回读链路可用
+ * 2. 从min_hz逐级升高写时钟，每级写入多组图案并用RAMRD回读比对
+ * 3. 出现错误即停止，取最后一个通过频率再降一级作为安全余量；
+ *    全部通过则取max_hz
+ * 4. 应用结果并调用LCD_SPI_SaveHz持久化
+ *
+ * 注意：校准会覆盖屏幕左上角64x4像素，建议在开机界面绘制前执行
+ */
+rt_err_t LCDx_SPI_AutoTune(lcd_st7789_t *lcd, rt_uint32_t min_hz, rt_uint32_t max_hz, rt_uint32_t step_hz, rt_uint32_t *result_hz)
+{
+#ifdef PKG_ST7789_USING_READ
+    uint8_t id[4];
+    rt_uint32_t hz, last_good = 0, chosen;
+    rt_uint32_t old_hz;
+    u8 round, failed = 0;
+
+    LCD_GateReady(lcd);
+    old_hz = lcd->spi_hz;
+    if (lcd->spi == RT_NULL || min_hz == 0 || max_hz < min_hz || step_hz == 0)
+        return -RT_EINVAL;
+
+    // 读ID确认SDO已连接
+    LCD_ReadData(lcd, 0x04, id, 3, 1);
+    if ((id[0] == 0x00 && id[1] == 0x00 && id[2] == 0x00) ||
+        (id[0] == 0xFF && id[1] == 0xFF && id[2] == 0xFF))
+    {
+        LOG_E("Panel read-back not available, check SDO wiring!");
+        return -RT_ENOSYS;
+    }
+    LOG_D("Panel ID: %02X %02X %02X", id[0], id[1], id[2]);
+
+    for (hz = min_hz; hz <= max_hz; hz += step_hz)
+    {
+        lcd->spi_hz = hz;
+        LCD_SPI_SetHz(lcd, hz);
+
+        for (round = 0; round < LCD_TUNE_ROUNDS; round++)
+        {
+            if (LCD_TuneVerify(lcd, round) != 0)
+            {
+                failed = 1;
+                break;
+            }
+        }
+        if (failed)
+        {
+            LOG_D("SPI %u Hz: errors", hz);
+            break;
+        }
+        last_good = hz;
+    }
+
+    if (last_good == 0)
+    {
+        lcd->spi_hz = old_hz;
+        LCD_SPI_SetHz(lcd, old_hz);
+        LOG_E("SPI write errors at minimum clock %u Hz!", min_hz);
+        return -RT_EIO;
+    }
+
+    chosen = (failed && last_good - step_hz >= min_hz && last_good > step_hz) ? last_good - step_hz : last_good;
+    lcd->spi_hz = chosen;
+    LCD_SPI_SetHz(lcd, chosen);
+    if (lcd == &lcd_default)
+        LCD_SPI_SaveHz(chosen); // 其他实例的结果通过result_hz返回，由应用自行保存到max_hz
+    LOG_I("SPI clock tuned: %u Hz (last good %u Hz)", chosen, last_good);
+
+    if (result_hz)
+        *result_hz = chosen;
+
+    return RT_EOK;
+#else
+    (void)lcd;
+    (void)min_hz;
+    (void)max_hz;
+    (void)step_hz;
+    (void)result_hz;
+    return -RT_ENOSYS;
+#endif
+}
+
+#ifdef PKG_ST7789_USING_READ
+/**
+ * @brief 每批回读的行数
+ * @param width 区域宽度
+ * @return 行数(至少1行)
+ *
+ * 功能说明：RAMRD每像素回读3字节，另需1字节空周期余量
+ */
+static u16 LCD_ReadRows(u16 width)
+{
+    u32 rows = (LCD_BATCH_BUFFER_SIZE - 1) / (width * 3);
+    return rows ? rows : 1;
+}
+
+/**
+ * @brief 回读GRAM到批量缓冲区
+ * @param lcd LCD实例
+ * @param x 起始X坐标
+ * @param y 起始Y坐标
+ * @param width 宽度
+ * @param height 高度
+ *
+ * 功能说明：
+ * 1. 设置窗口后发送RAMRD(0x2E)，丢弃8位空周期
+ * 2. 结果为RGB666，每像素3字节(R,G,B，高位有效)
+ * 3. 窗口保持不变，随后可直接RAMWR写回同一区域
+ */
+static void LCD_ReadRaw(lcd_st7789_t *lcd, u16 x, u16 y, u16 width, u16 height)
+{
+    LCD_SetWindows(lcd, x, y, width, height);
+    LCD_ReadData(lcd, 0x2E, lcd->batch, (u32)width * height * 3, 8);
+}
+
+/**
+ * @brief 区域半透明混合(读-改-写)
+ * @param lcd LCD实例
+ * @param img 叠加图片，为RT_NULL时使用color纯色
+ * @param color 纯色
+ * @param alpha 叠加透明度(0透明 255不透明)
+ *
+ * 功能说明：
+ * 1. 按批量缓冲区容量分批(整行)回读区域
+ * 2. 8位通道逐像素混合，结果就地压缩为RGB565字节流
+ * 3. 复用回读时设置的窗口，RAMWR一次写回整批
+ */
+static void LCD_BlendRegion(lcd_st7789_t *lcd, u16 x, u16 y, u16 width, u16 height, const u16 *img, u16 color, u8 alpha)
+{
+    u16 rows_max = LCD_ReadRows(width);
+    u16 row, rows;
+    u16 wa = alpha + 1, wb = 256 - alpha; // 权重和257，255*257>>8仍为255
+    u32 i, n;
+
+    for (row = 0; row < height; row += rows)
+    {
+        rows = (height - row > rows_max) ? rows_max : height - row;
+        n = (u32)width * rows;
+
+        LCD_ReadRaw(lcd, x, y + row, width, rows);
+
+        for (i = 0; i < n; i++)
+        {
+            const uint8_t *px = &lcd->batch[i * 3];
+            u16 c = img ? img[(u32)row * width + i] : color;
+            u16 sr = ((c >> 8) & 0xF8) | (c >> 13);
+            u16 sg = ((c >> 3) & 0xFC) | ((c >> 9) & 0x03);
+            u16 sb = ((c << 3) & 0xF8) | ((c >> 2) & 0x07);
+            u16 r = (sr * wa + px[0] * wb) >> 8;
+            u16 g = (sg * wa + px[1] * wb) >> 8;
+            u16 b = (sb * wa + px[2] * wb) >> 8;
+
+            // i*2 <= i*3，就地压缩不会覆盖尚未读取的数据
+            c = ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+            lcd->batch[i * 2] = c >> 8;
+            lcd->batch[i * 2 + 1] = c & 0xFF;
+        }
+
+        LCD_WriteRAM_Prepare(lcd);
+        LCD_DC_HIGH(lcd);
+        LCD_SpiSend(lcd, lcd->batch, n * 2);
+    }
+}
+#endif
+
+/**
+ * @brief 检查区域是否位于屏幕内
+ * @param lcd LCD实例
+ * @return RT_EOK合法，-RT_EINVAL越界或为空
+ */
+static rt_err_t LCD_CheckRect(lcd_st7789_t *lcd, u16 x, u16 y, u16 width, u16 height)
+{
+    if (width == 0 || height == 0 ||
+        (u32)x + width > lcd->dev->width || (u32)y + height > lcd->dev->height)
+        return -RT_EINVAL;
+    return RT_EOK;
+}
+
+/**
+ * @brief 回读屏幕区域像素
+ * @param lcd LCD实例
+ * @param x 起始X坐标
+ * @param y 起始Y坐标
+ * @param width 区域宽度
+ * @param height 区域高度
+ * @param buf 输出缓冲区(width*height个RGB565像素，行优先)
+ * @return RT_EOK成功，-RT_EINVAL区域越界，-RT_ENOSYS未开启回读
+ *
+ * 功能说明：
+ * 1. 以读时钟发送RAMRD(0x2E)，按批量缓冲区容量分批回读
+ * 2. 面板返回RGB666，截取高位转换为RGB565
+ * 3. 需连接面板SDO并开启PKG_ST7789_USING_READ
+ */
+rt_err_t LCDx_ReadRect(lcd_st7789_t *lcd, u16 x, u16 y, u16 width, u16 height, u16 *buf)
+{
+#ifdef PKG_ST7789_USING_READ
+    u16 rows_max, row, rows;
+    u32 i, n;
+
+    LCD_GateReady(lcd);
+    if (buf == RT_NULL || LCD_CheckRect(lcd, x, y, width, height) != RT_EOK)
+        return -RT_EINVAL;
+
+    LCD_PROF_ENTER(lcd, LCD_STAT_READ);
+    rows_max = LCD_ReadRows(width);
+    for (row = 0; row < height; row += rows)
+    {
+        rows = (height - row > rows_max) ? rows_max : height - row;
+        n = (u32)width * rows;
+
+        LCD_ReadRaw(lcd, x, y + row, width, rows);
+
+        for (i = 0; i < n; i++)
+        {
+            const uint8_t *px = &lcd->batch[i * 3];
+            *buf++ = ((px[0] & 0xF8) << 8) | ((px[1] & 0xFC) << 3) | (px[2] >> 3);
+        }
+    }
+    LCD_PROF_LEAVE(lcd);
+
+    return RT_EOK;
+#else
+    (void)lcd;
+    (void)x;
+    (void)y;
+    (void)width;
+    (void)height;
+    (void)buf;
+    return -RT_ENOSYS;
+#endif
+}
+
+/**
+ * @brief 半透明纯色叠加
+ * @param lcd LCD实例
+ * @param x 起始X坐标
+ * @param y 起始Y坐标
+ * @param width 区域宽度
+ * @param height 区域高度
+ * @param color 叠加颜色(RGB565)
+ * @param alpha 不透明度(0-255，0不改变屏幕，255等同LCD_Fill)
+ * @return RT_EOK成功，-RT_EINVAL区域越界，-RT_ENOSYS未开启回读
+ *
+ * 功能说明：
+ * 1. 回读屏幕内容与颜色混合后写回，无需帧缓冲
+ * 2. 适用于半透明弹窗背景、遮罩、高亮框等
+ */
+rt_err_t LCDx_BlendFill(lcd_st7789_t *lcd, u16 x, u16 y, u16 width, u16 height, u16 color, u8 alpha)
+{
+    LCD_GateReady(lcd);
+    if (LCD_CheckRect(lcd, x, y, width, height) != RT_EOK)
+        return -RT_EINVAL;
+#ifdef PKG_ST7789_USING_READ
+    if (alpha == 0)
+        return RT_EOK;
+    if (alpha == 255)
+    {
+        LCDx_Fill(lcd, x, y, x + width - 1, y + height - 1, color);
+        return RT_EOK;
+    }
+
+    LCD_PROF_ENTER(lcd, LCD_STAT_BLEND);
+    LCD_BlendRegion(lcd, x, y, width, height, RT_NULL, color, alpha);
+    LCD_PROF_LEAVE(lcd);
+    return RT_EOK;
+#else
+    (void)color;
+    (void)alpha;
+    return -RT_ENOSYS;
+#endif
+}
+
+/**
+ * @brief 半透明图片叠加
+ * @param lcd LCD实例
+ * @param x 起始X坐标
+ * @param y 起始Y坐标
+ * @param width 图片宽度
+ * @param height 图片高度
+ * @param img 图片数据(RGB565，行优先)
+ * @param alpha 不透明度(0-255，255等同LCD_ShowImage)
+ * @return RT_EOK成功，-RT_EINVAL参数错误，-RT_ENOSYS未开启回读
+ *
+ * 功能说明：
+ * 1. 回读屏幕内容与图片逐像素混合后写回
+ * 2. 适用于半透明光标、浮层、淡入淡出等效果
+ */
+rt_err_t LCDx_BlendImage(lcd_st7789_t *lcd, u16 x, u16 y, u16 width, u16 height, const u16 *img, u8 alpha)
+{
+    LCD_GateReady(lcd);
+    if (img == RT_NULL || LCD_CheckRect(lcd, x, y, width, height) != RT_EOK)
+        return -RT_EINVAL;
+#ifdef PKG_ST7789_USING_READ
+    if (alpha == 0)
+        return RT_EOK;
+    if (alpha == 255)
+    {
+        LCDx_ShowImage(lcd, x, y, width, height, img);
+        return RT_EOK;
+    }
+
+    LCD_PROF_ENTER(lcd, LCD_STAT_BLEND);
+    LCD_BlendRegion(lcd, x, y, width, height, img, 0, alpha);
+    LCD_PROF_LEAVE(lcd);
+    return RT_EOK;
+#else
+    (void)alpha;
+    return -RT_ENOSYS;
+#endif
+}
+
+/* 快速方向切换函数实现 */
+void LCDx_SetPortrait(lcd_st7789_t *lcd)
+{
+    LCD_GateReady(lcd);
+    lcd->dev->dir = 0; // 竖屏
+    lcd->dev->width = lcd->panel_w;
+    lcd->dev->height = lcd->panel_h;
+    LCDx_Scan_Dir(lcd, PORTRAIT);
+}
+
+void LCDx_SetLandscape(lcd_st7789_t *lcd)
+{
+    LCD_GateReady(lcd);
+    lcd->dev->dir = 1; // 横屏
+    lcd->dev->width = lcd->panel_h;
+    lcd->dev->height = lcd->panel_w;
+    LCDx_Scan_Dir(lcd, LANDSCAPE);
+}
+
+/**
+ * @brief 绘制测试图案
+ * @param lcd LCD实例
+ *
+ * 功能说明：
+ * 1. 绘制9宫格色块
+ * 2. 每种颜色不同亮度
+ * 3. 用于LCD功能测试
+ */
+static void LCD_DrawTestPattern(lcd_st7789_t *lcd)
+{
+    LOG_D("Starting optimized test pattern...");
+
+    /* 确保背光开启 */
+#if (BACKLIGHT_ACTIVE_LEVEL == 1)
+    LCD_BLK_LOW(lcd);
+#else
+    LCD_BLK_HIGH(lcd);
+#endif
+
+    /* 先清屏为白色 */
+    LCDx_Clear(lcd, WHITE);
+    rt_thread_mdelay(100);
+
+    /* 计算区域尺寸 */
+    uint16_t w = lcd->dev->width / 3;
+    uint16_t h = lcd->dev->height / 3;
+
+    /* 绘制9个色块 */
+    for (int row = 0; row < 3; row++)
+    {
+        for (int col = 0; col < 3; col++)
+        {
+            uint16_t color;
+            /* 确定基础颜色 */
+            switch (col)
+            {
+            case 0:
+                color = RED;
+                break;
+            case 1:
+                color = GREEN;
+                break;
+            case 2:
+                color = BLUE;
+                break;
+            }
+
+            /* 调整亮度 */
+            switch (row)
+            {
+            case 0:
+                color |= 0xFFFF;
+                break; // 全亮
+            case 1:
+                color &= 0xFFE0;
+                break; // 半亮
+            case 2:
+                color &= 0xF800;
+                break; // 暗
+            }
+
+            /* 计算区域坐标 */
+            uint16_t x1 = col * w;
+            uint16_t y1 = row * h;
+            uint16_t x2 = (col == 2) ? lcd->dev->width - 1 : (col + 1) * w - 1;
+            uint16_t y2 = (row == 2) ? lcd->dev->height - 1 : (row + 1) * h - 1;
+
+            LOG_D("Drawing block %d-%d: (%d,%d)-(%d,%d) color=0x%04X",
+                  row, col, x1, y1, x2, y2, color);
+
+            /* 填充区域 */
+            LCDx_Fill(lcd, x1, y1, x2, y2, color);
+
+            /* 添加短暂延时防止SPI过载 */
+            rt_thread_mdelay(10);
+        }
+    }
+    LOG_D("Test pattern complete");
+}
+
+/* RT-Thread设备初始化 */
+static void lcd_pin_init(lcd_st7789_t *lcd)
+{
+    rt_pin_mode(lcd->dc_pin, PIN_MODE_OUTPUT);
+    rt_pin_mode(lcd->cs_pin, PIN_MODE_OUTPUT);
+    if (lcd->res_pin >= 0)
+        rt_pin_mode(lcd->res_pin, PIN_MODE_OUTPUT);
+    if (lcd->blk_pin >= 0)
+        rt_pin_mode(lcd->blk_pin, PIN_MODE_OUTPUT);
+}
+
+/**
+ * @brief 硬件复位LCD
+ * @param lcd LCD实例
+ *
+ * 功能说明：未连接复位引脚(多块面板共用复位线时)改用软件复位SWRESET(0x01)
+ */
+static void LCD_HardReset(lcd_st7789_t *lcd)
+{
+    if (lcd->res_pin < 0)
+    {
+        LCD_WR_REG(lcd, 0x01);
+        rt_thread_mdelay(120);
+        return;
+    }
+
+    rt_thread_mdelay(25);
+    LCD_RES_LOW(lcd);
+    rt_thread_mdelay(25);
+    LCD_RES_HIGH(lcd);
+    rt_thread_mdelay(50);
+}
+
+/**
+ * @brief LCD初始化
+ * @param lcd LCD实例
+ *
+ * 功能说明：
+ * 1. 硬件复位并重新执行初始化序列
+ * 2. 保持当前横竖屏方向
+ * 3. 在LCDx_Display_Dir之后恢复局部显示/空闲模式
+ *
+ * 注意：SPI设备须已由LCDx_Attach挂载
+ */
+void LCDx_Init(lcd_st7789_t *lcd)
+{
+    LCD_GateReady(lcd);
+    if (lcd->spi == RT_NULL)
+    {
+        LOG_E("SPI device not attached, call LCDx_Attach first!");
+        return;
+    }
+
+    LCD_HardReset(lcd);
+    LCD_INIT_CODE(lcd, lcd->dev->dir);
+    LCD_RestoreModes(lcd);
+}
+
+/**
+ * @brief 挂载SPI设备
+ * @param lcd LCD实例(已填写硬件配置)
+ * @return RT_EOK成功，-RT_ENOMEM缓冲区申请失败，-RT_ERROR找不到SPI设备
+ *
+ * 功能说明：申请缓冲区、复位状态、初始化引脚并配置SPI，不访问面板、不延时
+ */
+static rt_err_t LCD_AttachBus(lcd_st7789_t *lcd)
+{
+    struct rt_spi_configuration spi_config;
+
+    RT_ASSERT(lcd != RT_NULL);
+
+    if (lcd->batch == RT_NULL)
+    {
+        lcd->batch = (u8 *)rt_malloc(LCD_BATCH_BUFFER_SIZE);
+        if (lcd->batch == RT_NULL)
+            return -RT_ENOMEM;
+        lcd->batch_owned = 1;
+    }
+    lcd->fill_count = 0;
+    if (lcd->dev == RT_NULL)
+        lcd->dev = &lcd->dev_data;
+    if (lcd->panel != RT_NULL)
+    {
+        lcd->panel_w = lcd->panel->width;
+        lcd->panel_h = lcd->panel->height;
+    }
+
+    lcd->ready = 0;
+    lcd->bulk_fmt = LCD_PIXFMT_RGB565;
+    lcd->mode.start_row = 0;
+    lcd->mode.end_row = lcd->panel_h - 1;
+    lcd->mode.partial = 0;
+    lcd->mode.idle = 0;
+    lcd->timing.bpa = 0x0c;
+    lcd->timing.fpa = 0x0c;
+    lcd->timing.rtna = 0x0f;
+#ifdef PKG_ST7789_USING_ASYNC_INIT
+    lcd->init_tid = RT_NULL;
+#endif
+#ifdef LCD_USING_PROFILE
+    lcd->prof_op = LCD_STAT_OTHER;
+    lcd->prof_depth = 0;
+    lcd->prof_mute = 0;
+#ifdef PKG_ST7789_USING_STATS
+    rt_memset(lcd->stats, 0, sizeof(lcd->stats));
+#endif
+#ifdef PKG_ST7789_USING_TRACE
+    rt_memset(lcd->trace_win, 0, sizeof(lcd->trace_win));
+#endif
+#ifdef PKG_ST7789_USING_OVERLAY
+    lcd->overlay = RT_NULL;
+#endif
+#ifdef PKG_ST7789_PROFILE_USING_DWT
+    LCD_DEMCR |= 1UL << 24; // TRCENA
+    LCD_DWT_CTRL |= 1UL;    // CYCCNTENA
+#endif
+#endif
+
+    /* 初始化引脚 */
+    lcd_pin_init(lcd);
+
+    /* 附加SPI设备 */
+    rt_hw_spi_device_attach(lcd->spi_bus, lcd->spi_name, lcd->cs_pin);
+
+    /* 查找SPI设备 */
+    lcd->spi = (struct rt_spi_device *)rt_device_find(lcd->spi_name);
+    if (lcd->spi == RT_NULL)
+    {
+        LOG_E("SPI device %s not found!", lcd->spi_name);
+        return -RT_ERROR;
+    }
+
+    /* 配置SPI参数，默认实例优先使用校准保存的时钟 */
+    spi_config.data_width = 8;
+    spi_config.max_hz = (lcd == &lcd_default) ? LCD_SPI_LoadHz() : 0;
+    if (spi_config.max_hz == 0)
+        spi_config.max_hz = lcd->max_hz ? lcd->max_hz : LCD_SPI_MAX_HZ;
+    spi_config.mode = RT_SPI_MASTER | RT_SPI_MODE_0 | RT_SPI_MSB;
+    rt_spi_configure(lcd->spi, &spi_config);
+    lcd->spi_hz = spi_config.max_hz;
+
+    return RT_EOK;
+}
+
+/**
+ * @brief 复位面板并执行初始化序列
+ * @param lcd LCD实例
+ *
+ * 功能说明：包含复位与退出睡眠共约230ms的延时，结束后置就绪标志
+ */
+static void LCD_PowerOn(lcd_st7789_t *lcd)
+{
+    LCD_HardReset(lcd);
+
+    /* 执行LCD初始化序列 */
+    LCD_INIT_CODE(lcd, Landscape);
+    LCD_RestoreModes(lcd);
+    rt_thread_mdelay(10); // 确保方向设置完成
+
+    lcd->ready = 1;
+}
+
+/**
+ * @brief 挂载并初始化一块面板
+ * @param lcd LCD实例(已填写硬件配置)
+ * @return RT_EOK成功，-RT_ENOMEM缓冲区申请失败，-RT_ERROR找不到SPI设备
+ *
+ * 功能说明：
+ * 1. 初始化引脚，把SPI设备挂到指定总线并配置时钟
+ * 2. 复位面板，以横屏方向执行初始化序列
+ * 3. 各实例状态互相独立，不同SPI总线上的面板可由不同线程并行绘制；
+ *    同一实例的接口不可重入，多线程共用一块面板时需自行加锁
+ */
+rt_err_t LCDx_Attach(lcd_st7789_t *lcd)
+{
+    rt_err_t ret = LCD_AttachBus(lcd);
+
+    if (ret != RT_EOK)
+        return ret;
+
+    LCD_PowerOn(lcd);
+    return RT_EOK;
+}
+
+/**
+ * @brief 卸载面板，释放驱动申请的资源
+ * @param lcd LCD实例
+ *
+ * 功能说明：
+ * 1. 后台初始化尚未完成时先等待其结束
+ * 2. 关闭TE中断，释放TE信号量、就绪事件、性能叠加层，以及由驱动申请的批量缓冲区
+ * 3. 不改变面板显示内容；SPI设备仍留在总线上，再次LCDx_Attach时直接复用
+ * 4. 调用前应停止使用该实例的绘图线程，并注销其图形设备/LVGL显示
+ */
+void LCDx_Detach(lcd_st7789_t *lcd)
+{
+    RT_ASSERT(lcd != RT_NULL);
+
+#ifdef PKG_ST7789_USING_ASYNC_INIT
+    if (!lcd->ready && lcd->init_tid != RT_NULL)
+        LCDx_WaitReady(lcd, RT_WAITING_FOREVER);
+    if (lcd->ready_inited)
+    {
+        rt_event_detach(&lcd->ready_evt);
+        lcd->ready_inited = 0;
+    }
+    lcd->init_tid = RT_NULL;
+#endif
+#ifdef PKG_ST7789_USING_TE
+    if (lcd->te_enabled)
+        LCDx_TE_Enable(lcd, 0);
+    if (lcd->te_inited)
+    {
+        rt_sem_detach(&lcd->te_sem);
+        lcd->te_inited = 0;
+    }
+#endif
+#ifdef PKG_ST7789_USING_OVERLAY
+    if (lcd->overlay != RT_NULL)
+    {
+        rt_free(lcd->overlay);
+        lcd->overlay = RT_NULL;
+    }
+#endif
+
+    if (lcd->batch_owned)
+    {
+        rt_free(lcd->batch);
+        lcd->batch = RT_NULL;
+        lcd->batch_owned = 0;
+    }
+    lcd->fill_count = 0;
+    lcd->spi = RT_NULL;
+    lcd->ready = 0;
+}
+
+#ifdef PKG_ST7789_USING_ASYNC_INIT
+/**
+ * @brief 后台初始化线程
+ * @param parameter LCD实例
+ */
+static void lcd_init_entry(void *parameter)
+{
+    lcd_st7789_t *lcd = (lcd_st7789_t *)parameter;
+
+    LCD_PowerOn(lcd);
+    rt_event_send(&lcd->ready_evt, LCD_EVT_READY);
+    if (lcd->on_ready)
+        lcd->on_ready(lcd);
+}
+#endif
+
+/**
+ * @brief 挂载面板并在后台线程中初始化
+ * @param lcd LCD实例(已填写硬件配置)
+ * @return RT_EOK成功，-RT_ENOMEM缓冲区申请失败，-RT_ERROR找不到SPI设备，
+ *         未开启PKG_ST7789_USING_ASYNC_INIT时返回-RT_ENOSYS
+ *
+ * 功能说明：
+ * 1. 只同步完成引脚与SPI配置，复位和退出睡眠的延时由初始化线程承担，立即返回
+ * 2. 初始化完成后发送就绪事件并调用lcd->on_ready
+ * 3. 就绪前其它线程的绘图调用阻塞排队，就绪后依次执行；也可用LCDx_WaitReady等待
+ * 4. 线程创建失败时退化为同步初始化
+ */
+rt_err_t LCDx_AttachAsync(lcd_st7789_t *lcd)
+{
+#ifdef PKG_ST7789_USING_ASYNC_INIT
+    rt_err_t ret = LCD_AttachBus(lcd);
+
+    if (ret != RT_EOK)
+        return ret;
+
+    if (!lcd->ready_inited)
+    {
+        rt_event_init(&lcd->ready_evt, "lcd_rdy", RT_IPC_FLAG_FIFO);
+        lcd->ready_inited = 1;
+    }
+    rt_event_control(&lcd->ready_evt, RT_IPC_CMD_RESET, RT_NULL);
+
+    lcd->init_tid = rt_thread_create("lcd_on", lcd_init_entry, lcd, LCD_INIT_THREAD_STACK, LCD_INIT_THREAD_PRIO, 10);
+    if (lcd->init_tid == RT_NULL)
+    {
+        LOG_W("create init thread failed, init synchronously");
+        lcd_init_entry(lcd);
+        return RT_EOK;
+    }
+    rt_thread_startup(lcd->init_tid);
+
+    return RT_EOK;
+#else
+    (void)lcd;
+    return -RT_ENOSYS;
+#endif
+}
+
+/**
+ * @brief 等待面板初始化完成
+ * @param lcd LCD实例
+ * @param timeout 超时时间(ms)，RT_WAITING_FOREVER为永久等待
+ * @return RT_EOK已就绪，-RT_ETIMEOUT超时，-RT_ERROR尚未挂载
+ */
+rt_err_t LCDx_WaitReady(lcd_st7789_t *lcd, rt_int32_t timeout)
+{
+#ifdef PKG_ST7789_USING_ASYNC_INIT
+    rt_uint32_t set;
+#endif
+
+    if (lcd->ready)
+        return RT_EOK;
+
+#ifdef PKG_ST7789_USING_ASYNC_INIT
+    if (lcd->init_tid == RT_NULL)
+        return -RT_ERROR;
+
+    if (timeout != RT_WAITING_FOREVER)
+        timeout = rt_tick_from_millisecond(timeout);
+
+    return rt_event_recv(&lcd->ready_evt, LCD_EVT_READY, RT_EVENT_FLAG_OR, timeout, &set);
+#else
+    (void)timeout;
+    return -RT_ERROR;
+#endif
+}
+
+/**
+ * @brief 默认面板异步初始化完成回调
+ * @param lcd 默认实例
+ *
+ * 功能说明：弱函数，在初始化线程中调用，可在应用中重写以绘制开机画面
+ */
+RT_WEAK void LCD_OnReady(lcd_st7789_t *lcd)
+{
+    (void)lcd;
+}
+
+/**
+ * @brief 获取默认实例
+ * @return 由Kconfig配置、spi_lcd_init挂载的实例
+ */
+lcd_st7789_t *LCD_GetDefault(void)
+{
+    return &lcd_default;
+}
+
+int spi_lcd_init(void)
+{
+#ifdef PKG_ST7789_USING_ASYNC_INIT
+    return LCDx_AttachAsync(&lcd_default);
+#else
+    return LCDx_Attach(&lcd_default);
+#endif
+}
+INIT_COMPONENT_EXPORT(spi_lcd_init);
+
+/* ================= 兼容接口：作用于默认实例 ================= */
+
+void LCD_SetCursor(uint16_t Xpos, uint16_t Ypos)
+{
+    LCDx_SetCursor(&lcd_default, Xpos, Ypos);
+}
+
+void LCD_SetBulkFormat(u8 fmt)
+{
+    LCDx_SetBulkFormat(&lcd_default, fmt);
+}
+
+void LCD_Clear(uint16_t Color)
+{
+    LCDx_Clear(&lcd_default, Color);
+}
+
+void LCD_DrawPoint(u16 x, u16 y, u16 color)
+{
+    LCDx_DrawPoint(&lcd_default, x, y, color);
+}
+
+void LCD_DrawPoints(u16 *points_x, u16 *points_y, u16 point_count, u16 color)
+{
+    LCDx_DrawPoints(&lcd_default, points_x, points_y, point_count, color);
+}
+
+void LCD_Fill(u16 sx, u16 sy, u16 ex, u16 ey, u16 color)
+{
+    LCDx_Fill(&lcd_default, sx, sy, ex, ey, color);
+}
+
+void LCD_FillRects(const lcd_rect_t *rects, u16 n, u16 color)
+{
+    LCDx_FillRects(&lcd_default, rects, n, color);
+}
+
+void LCD_FillRectsColor(const lcd_rect_t *rects, const u16 *colors, u16 n)
+{
+    LCDx_FillRectsColor(&lcd_default, rects, colors, n);
+}
+
+void LCD_ShowChar(uint16_t x, uint16_t y, char chr, uint8_t size, uint8_t mode, uint16_t color, uint16_t bg_color)
+{
+    LCDx_ShowChar(&lcd_default, x, y, chr, size, mode, color, bg_color);
+}
+
+void LCD_ShowString(u16 x, u16 y, u16 width, u16 height, u8 size, u8 *p, u16 color, uint16_t bg_color)
+{
+    LCDx_ShowString(&lcd_default, x, y, width, height, size, p, color, bg_color);
+}
+
+void LCD_ShowNum(u16 x, u16 y, u32 num, u8 len, u8 size, u16 color, uint16_t bg_color)
+{
+    LCDx_ShowNum(&lcd_default, x, y, num, len, size, color, bg_color);
+}
+
+void LCD_ShowxNum(u16 x, u16 y, u32 num, u8 len, u8 size, u8 mode, u16 color, uint16_t bg_color)
+{
+    LCDx_ShowxNum(&lcd_default, x, y, num, len, size, mode, color, bg_color);
+}
+
+void LCD_NumField_Show(lcd_num_field_t *f, u32 value)
+{
+    LCDx_NumField_Show(&lcd_default, f, value);
+}
+
+int LCD_Printf(u16 x, u16 y, lcd_text_box_t *box, u8 size, const char *fmt, ...)
+{
+    va_list args;
+    int lines;
+
+    LCD_GateReady(&lcd_default);
+    va_start(args, fmt);
+    lines = LCD_VPrintf(&lcd_default, x, y, box, size, fmt, args);
+    va_end(args);
+    return lines;
+}
+
+void LCD_ShowImage(u16 x, u16 y, u16 width, u16 height, const u16 *p)
+{
+    LCDx_ShowImage(&lcd_default, x, y, width, height, p);
+}
+
+void LCD_BlitImage(u16 x, u16 y, const u16 *src, u16 stride, u16 sx, u16 sy, u16 width, u16 height)
+{
+    LCDx_BlitImage(&lcd_default, x, y, src, stride, sx, sy, width, height);
+}
+
+void LCD_ShowImageRotate(u16 x, u16 y, u16 width, u16 height, const u16 *p, u8 mode)
+{
+    LCDx_ShowImageRotate(&lcd_default, x, y, width, height, p, mode);
+}
+
+void LCD_DrawLine(u16 x1, u16 y1, u16 x2, u16 y2, u16 color)
+{
+    LCDx_DrawLine(&lcd_default, x1, y1, x2, y2, color);
+}
+
+void LCD_DrawRectangle(u16 x1, u16 y1, u16 x2, u16 y2, u16 color)
+{
+    LCDx_DrawRectangle(&lcd_default, x1, y1, x2, y2, color);
+}
+
+void Draw_Circle(u16 x0, u16 y0, u8 r, u16 color)
+{
+    LCDx_Draw_Circle(&lcd_default, x0, y0, r, color);
+}
+
+void LCD_Scan_Dir(u8 dir)
+{
+    LCDx_Scan_Dir(&lcd_default, dir);
+}
+
+void LCD_Display_Dir(u8 dir)
+{
+    LCDx_Display_Dir(&lcd_default, dir);
+}
+
+void LCD_SetPartialArea(u16 start_row, u16 end_row)
+{
+    LCDx_SetPartialArea(&lcd_default, start_row, end_row);
+}
+
+void LCD_PartialMode(u8 enable)
+{
+    LCDx_PartialMode(&lcd_default, enable);
+}
+
+void LCD_IdleMode(u8 enable)
+{
+    LCDx_IdleMode(&lcd_default, enable);
+}
+
+void LCD_SetFrameRate(u8 rtna)
+{
+    LCDx_SetFrameRate(&lcd_default, rtna);
+}
+
+void LCD_SetRefreshRate(u16 hz)
+{
+    LCDx_SetRefreshRate(&lcd_default, hz);
+}
+
+void LCD_SetPorch(u8 back_porch, u8 front_porch)
+{
+    LCDx_SetPorch(&lcd_default, back_porch, front_porch);
+}
+
+u16 LCD_GetFrameRate(void)
+{
+    return LCDx_GetFrameRate(&lcd_default);
+}
+
+u16 LCD_GetFlushRate(u16 width, u16 height, u8 te_sync)
+{
+    return LCDx_GetFlushRate(&lcd_default, width, height, te_sync);
+}
+
+rt_err_t LCD_TE_Enable(u8 enable)
+{
+    return LCDx_TE_Enable(&lcd_default, enable);
+}
+
+rt_err_t LCD_WaitVSync(rt_int32_t timeout)
+{
+    return LCDx_WaitVSync(&lcd_default, timeout);
+}
+
+void LCD_Color_Fill(u16 sx, u16 sy, u16 ex, u16 ey, u16 *color)
+{
+    LCDx_Color_Fill(&lcd_default, sx, sy, ex, ey, color);
+}
+
+void LCD_DispFlush(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, const uint16_t *pData)
+{
+    LCDx_DispFlush(&lcd_default, x1, y1, x2, y2, pData);
+}
+
+void LCD_DispFlushSync(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, const uint16_t *pData)
+{
+    LCDx_DispFlushSync(&lcd_default, x1, y1, x2, y2, pData);
+}
+
+void LCD_DispFlushWire(u16 x1, u16 y1, u16 x2, u16 y2, const void *pData)
+{
+    LCDx_DispFlushWire(&lcd_default, x1, y1, x2, y2, pData);
+}
+
+void LCD_PalFB_FlushArea(const lcd_pal_fb_t *fb, u16 x, u16 y, u16 sx, u16 sy, u16 ex, u16 ey)
+{
+    LCDx_PalFB_FlushArea(&lcd_default, fb, x, y, sx, sy, ex, ey);
+}
+
+void LCD_PalFB_Flush(const lcd_pal_fb_t *fb, u16 x, u16 y)
+{
+    LCDx_PalFB_Flush(&lcd_default, fb, x, y);
+}
+
+void LCD_MonoFB_FlushArea(const lcd_mono_fb_t *fb, u16 x, u16 y, u16 sx, u16 sy, u16 ex, u16 ey)
+{
+    LCDx_MonoFB_FlushArea(&lcd_default, fb, x, y, sx, sy, ex, ey);
+}
+
+void LCD_MonoFB_Flush(const lcd_mono_fb_t *fb, u16 x, u16 y)
+{
+    LCDx_MonoFB_Flush(&lcd_default, fb, x, y);
+}
+
+void LCD_RgbFB_FlushArea(const lcd_rgb_fb_t *fb, u16 x, u16 y, u16 sx, u16 sy, u16 ex, u16 ey)
+{
+    LCDx_RgbFB_FlushArea(&lcd_default, fb, x, y, sx, sy, ex, ey);
+}
+
+void LCD_RgbFB_Flush(const lcd_rgb_fb_t *fb, u16 x, u16 y)
+{
+    LCDx_RgbFB_Flush(&lcd_default, fb, x, y);
+}
+
+void LCD_Sprite_Draw(const lcd_sprite_t *spr, u16 x, u16 y)
+{
+    LCDx_Sprite_Draw(&lcd_default, spr, x, y);
+}
+
+void LCD_ShowAlphaImage(u16 x, u16 y, const lcd_alpha_img_t *img, u16 bg_color)
+{
+    LCDx_ShowAlphaImage(&lcd_default, x, y, img, bg_color);
+}
+
+rt_uint32_t LCD_SPI_GetHz(void)
+{
+    return LCDx_SPI_GetHz(&lcd_default);
+}
+
+rt_err_t LCD_SPI_AutoTune(rt_uint32_t min_hz, rt_uint32_t max_hz, rt_uint32_t step_hz, rt_uint32_t *result_hz)
+{
+    return LCDx_SPI_AutoTune(&lcd_default, min_hz, max_hz, step_hz, result_hz);
+}
+
+void LCD_FillLinearGradient(u16 sx, u16 sy, u16 ex, u16 ey, u16 x0, u16 y0, u16 c0, u16 x1, u16 y1, u16 c1)
+{
+    LCDx_FillLinearGradient(&lcd_default, sx, sy, ex, ey, x0, y0, c0, x1, y1, c1);
+}
+
+void LCD_FillRadialGradient(u16 sx, u16 sy, u16 ex, u16 ey, u16 cx, u16 cy, u16 r, u16 c0, u16 c1)
+{
+    LCDx_FillRadialGradient(&lcd_default, sx, sy, ex, ey, cx, cy, r, c0, c1);
+}
+
+void LCD_FillPattern(u16 sx, u16 sy, u16 ex, u16 ey, const u16 *tile, u16 tw, u16 th)
+{
+    LCDx_FillPattern(&lcd_default, sx, sy, ex, ey, tile, tw, th);
+}
+
+rt_err_t LCD_ReadRect(u16 x, u16 y, u16 width, u16 height, u16 *buf)
+{
+    return LCDx_ReadRect(&lcd_default, x, y, width, height, buf);
+}
+
+rt_err_t LCD_BlendFill(u16 x, u16 y, u16 width, u16 height, u16 color, u8 alpha)
+{
+    return LCDx_BlendFill(&lcd_default, x, y, width, height, color, alpha);
+}
+
+rt_err_t LCD_BlendImage(u16 x, u16 y, u16 width, u16 height, const u16 *img, u8 alpha)
+{
+    return LCDx_BlendImage(&lcd_default, x, y, width, height, img, alpha);
+}
+
+void LCD_SetPortrait(void)
+{
+    LCDx_SetPortrait(&lcd_default);
+}
+
+void LCD_SetLandscape(void)
+{
+    LCDx_SetLandscape(&lcd_default);
+}
+
+void LCD_Init(void)
+{
+    LCDx_Init(&lcd_default);
+}
+
+rt_err_t LCD_WaitReady(rt_int32_t timeout)
+{
+    return LCDx_WaitReady(&lcd_default, timeout);
 }
-INIT_COMPONENT_EXPORT(spi_lcd_init);
@@ -0,0 +1,367 @@
+/*
+ * =====================================================================================
+ * @file    LCD_ST7789_Graphic.c
+ * @brief   ST7789 RT-Thread图形设备(RT_Device_Class_Graphic)适配
+ * @author  Passionate0424
+ * @date    2025-07-11
+ * @version 1.0.0
+ *
+ * 主要功能：
+ *   - 把LCD实例注册为RT-Thread图形设备，供GUI通过rt_device_find发现
+ *   - 实现GET_INFO/RECT_UPDATE等控制命令
+ *   - 实现set_pixel/get_pixel/draw_hline/draw_vline/blit_line绘图操作
+ *
+ * 说明：
+ *   1. 驱动不带帧缓冲(framebuffer为RT_NULL)，绘图操作直接写入面板GRAM
+ *   2. 水平/垂直线与行传送整段批量发送，一条线只设置一次窗口
+ *   3. 图形操作函数没有设备参数，每个注册槽位使用一组独立的函数
+ * =====================================================================================
+ */
+
+#include "LCD_ST7789.h"
+#include <rtthread.h>
+#include <rtdevice.h>
+
+#define DBG_TAG "lcd.gfx"
+#include <rtdbg.h>
+
+#define LCD_GFX_MAX 3 // 最多注册的图形设备数
+
+/**
+ * @brief 图形设备
+ */
+struct lcd_graphic
+{
+    struct rt_device parent;           // RT-Thread设备
+    struct rt_device_graphic_ops *ops; // 本槽位的绘图操作
+    lcd_st7789_t *lcd;                 // 对应的LCD实例
+    u16 *line;                         // 行传送中转缓冲(防止像素指针未按2字节对齐)
+    u16 line_len;                      // 中转缓冲像素数
+};
+
+static struct lcd_graphic lcd_gfx[LCD_GFX_MAX];
+
+/**
+ * @brief 读取一个像素值
+ * @param pixel GUI传入的像素指针(RGB565，主机字节序，可能未对齐)
+ * @return RGB565颜色
+ */
+static u16 lcd_gfx_color(const char *pixel)
+{
+    u16 color;
+    rt_memcpy(&color, pixel, sizeof(color));
+    return color;
+}
+
+/**
+ * @brief 画点
+ * @param gfx 图形设备
+ * @param pixel 颜色
+ * @param x X坐标
+ * @param y Y坐标
+ */
+static void lcd_gfx_set_pixel(struct lcd_graphic *gfx, const char *pixel, int x, int y)
+{
+    _lcd_dev *dev = gfx->lcd->dev;
+
+    if (x < 0 || y < 0 || x >= dev->width || y >= dev->height)
+        return;
+
+    LCDx_DrawPoint(gfx->lcd, x, y, lcd_gfx_color(pixel));
+}
+
+/**
+ * @brief 读点
+ * @param gfx 图形设备
+ * @param pixel 输出颜色
+ * @param x X坐标
+ * @param y Y坐标
+ *
+ * 功能说明：开启PKG_ST7789_USING_READ时从GRAM回读，否则返回黑色
+ */
+static void lcd_gfx_get_pixel(struct lcd_graphic *gfx, char *pixel, int x, int y)
+{
+    _lcd_dev *dev = gfx->lcd->dev;
+    u16 color = 0;
+
+    if (x >= 0 && y >= 0 && x < dev->width && y < dev->height)
+        LCDx_ReadRect(gfx->lcd, x, y, 1, 1, &color);
+
+    rt_memcpy(pixel, &color, sizeof(color));
+}
+
+/**
+ * @brief 画水平线
+ * @param gfx 图形设备
+ * @param pixel 颜色
+ * @param x1 起始X坐标
+ * @param x2 结束X坐标(不含)
+ * @param y Y坐标
+ *
+ * 功能说明：按RT-Thread图形设备约定绘制[x1, x2)，整段一次填充
+ */
+static void lcd_gfx_draw_hline(struct lcd_graphic *gfx, const char *pixel, int x1, int x2, int y)
+{
+    _lcd_dev *dev = gfx->lcd->dev;
+
+    if (x1 < 0)
+        x1 = 0;
+    if (x2 > dev->width)
+        x2 = dev->width;
+    if (y < 0 || y >= dev->height || x1 >= x2)
+        return;
+
+    LCDx_Fill(gfx->lcd, x1, y, x2 - 1, y, lcd_gfx_color(pixel));
+}
+
+/**
+ * @brief 画垂直线
+ * @param gfx 图形设备
+ * @param pixel 颜色
+ * @param x X坐标
+ * @param y1 起始Y坐标
+ * @param y2 结束Y坐标(不含)
+ *
+ * 功能说明：按RT-Thread图形设备约定绘制[y1, y2)，整段一次填充
+ */
+static void lcd_gfx_draw_vline(struct lcd_graphic *gfx, const char *pixel, int x, int y1, int y2)
+{
+    _lcd_dev *dev = gfx->lcd->dev;
+
+    if (y1 < 0)
+        y1 = 0;
+    if (y2 > dev->height)
+        y2 = dev->height;
+    if (x < 0 || x >= dev->width || y1 >= y2)
+        return;
+
+    LCDx_Fill(gfx->lcd, x, y1, x, y2 - 1, lcd_gfx_color(pixel));
+}
+
+/**
+ * @brief 行传送
+ * @param gfx 图形设备
+ * @param pixel 像素数据(RGB565，主机字节序)
+ * @param x 起始X坐标
+ * @param y Y坐标
+ * @param size 像素数
+ *
+ * 功能说明：
+ * 1. 裁剪到屏幕范围
+ * 2. 数据已按2字节对齐时直接批量发送，否则先复制到中转缓冲
+ */
+static void lcd_gfx_blit_line(struct lcd_graphic *gfx, const char *pixel, int x, int y, rt_size_t size)
+{
+    _lcd_dev *dev = gfx->lcd->dev;
+    const u16 *src;
+    int w = (int)size;
+
+    if (x < 0)
+    {
+        pixel += -x * 2;
+        w += x;
+        x = 0;
+    }
+    if (x + w > dev->width)
+        w = dev->width - x;
+    if (y < 0 || y >= dev->height || w <= 0)
+        return;
+
+    if (((rt_ubase_t)pixel & 1) == 0)
+    {
+        src = (const u16 *)pixel;
+    }
+    else
+    {
+        if (w > gfx->line_len)
+            w = gfx->line_len;
+        rt_memcpy(gfx->line, pixel, w * 2);
+        src = gfx->line;
+    }
+
+    LCDx_ShowImage(gfx->lcd, x, y, w, 1, src);
+}
+
+/* 每个槽位一组不带设备参数的绘图操作 */
+#define LCD_GFX_OPS_DEFINE(n)                                                          \
+    static void lcd_gfx_set_pixel_##n(const char *pixel, int x, int y)                 \
+    {                                                                                  \
+        lcd_gfx_set_pixel(&lcd_gfx[n], pixel, x, y);                                   \
+    }                                                                                  \
+    static void lcd_gfx_get_pixel_##n(char *pixel, int x, int y)                       \
+    {                                                                                  \
+        lcd_gfx_get_pixel(&lcd_gfx[n], pixel, x, y);                                   \
+    }                                                                                  \
+    static void lcd_gfx_draw_hline_##n(const char *pixel, int x1, int x2, int y)       \
+    {                                                                                  \
+        lcd_gfx_draw_hline(&lcd_gfx[n], pixel, x1, x2, y);                             \
+    }                                                                                  \
+    static void lcd_gfx_draw_vline_##n(const char *pixel, int x, int y1, int y2)       \
+    {                                                                                  \
+        lcd_gfx_draw_vline(&lcd_gfx[n], pixel, x, y1, y2);                             \
+    }                                                                                  \
+    static void lcd_gfx_blit_line_##n(const char *pixel, int x, int y, rt_size_t size) \
+    {                                                                                  \
+        lcd_gfx_blit_line(&lcd_gfx[n], pixel, x, y, size);                             \
+    }                                                                                  \
+    static struct rt_device_graphic_ops lcd_gfx_ops_##n = {                            \
+        lcd_gfx_set_pixel_##n,                                                         \
+        lcd_gfx_get_pixel_##n,                                                         \
+        lcd_gfx_draw_hline_##n,                                                        \
+        lcd_gfx_draw_vline_##n,                                                        \
+        lcd_gfx_blit_line_##n,                                                         \
+    };
+
+LCD_GFX_OPS_DEFINE(0)
+LCD_GFX_OPS_DEFINE(1)
+LCD_GFX_OPS_DEFINE(2)
+
+static struct rt_device_graphic_ops *const lcd_gfx_ops[LCD_GFX_MAX] = {
+    &lcd_gfx_ops_0,
+    &lcd_gfx_ops_1,
+    &lcd_gfx_ops_2,
+};
+
+/**
+ * @brief 图形设备控制
+ * @param dev 设备
+ * @param cmd 控制命令
+ * @param args 命令参数
+ * @return RT_EOK成功，-RT_EINVAL不支持的命令
+ *
+ * 功能说明：
+ * 1. GET_INFO：返回当前方向下的宽高，RGB565格式，无帧缓冲
+ * 2. RECT_UPDATE：绘图操作已直接写入GRAM，无需额外刷新；开启叠加层时作为一帧结束标记
+ */
+static rt_err_t lcd_gfx_control(rt_device_t dev, int cmd, void *args)
+{
+    struct lcd_graphic *gfx = (struct lcd_graphic *)dev;
+
+    switch (cmd)
+    {
+    case RTGRAPHIC_CTRL_GET_INFO:
+    {
+        struct rt_device_graphic_info *info = (struct rt_device_graphic_info *)args;
+
+        RT_ASSERT(info != RT_NULL);
+        LCDx_WaitReady(gfx->lcd, RT_WAITING_FOREVER); // 异步初始化时宽高在方向设置后才确定
+        info->pixel_format = RTGRAPHIC_PIXEL_FORMAT_RGB565;
+        info->bits_per_pixel = 16;
+        info->width = gfx->lcd->dev->width;
+        info->height = gfx->lcd->dev->height;
+        info->pitch = info->width * 2;
+        info->framebuffer = RT_NULL;
+        info->smem_len = 0;
+        break;
+    }
+
+    case RTGRAPHIC_CTRL_RECT_UPDATE:
+#ifdef PKG_ST7789_USING_OVERLAY
+    {
+        struct rt_device_rect_info *rect = (struct rt_device_rect_info *)args;
+
+        if (rect != RT_NULL && rect->width && rect->height)
+            LCDx_OverlayDamage(gfx->lcd, rect->x, rect->y, rect->x + rect->width - 1, rect->y + rect->height - 1);
+        LCDx_OverlayFrame(gfx->lcd);
+        break;
+    }
+#endif
+    case RTGRAPHIC_CTRL_POWERON:
+    case RTGRAPHIC_CTRL_POWEROFF:
+    case RTGRAPHIC_CTRL_SET_MODE:
+        break;
+
+    default:
+        return -RT_EINVAL;
+    }
+
+    return RT_EOK;
+}
+
+#ifdef RT_USING_DEVICE_OPS
+static const struct rt_device_ops lcd_gfx_dev_ops = {
+    RT_NULL,
+    RT_NULL,
+    RT_NULL,
+    RT_NULL,
+    RT_NULL,
+    lcd_gfx_control,
+};
+#endif
+
+/**
+ * @brief 把LCD实例注册为图形设备
+ * @param lcd LCD实例(须已挂载)
+ * @param name 设备名
+ * @return RT_EOK成功，-RT_ERROR实例未挂载，-RT_EFULL槽位已满，-RT_ENOMEM内存不足
+ *
+ * 功能说明：
+ * 1. 占用一个空闲槽位，绑定该槽位的绘图操作
+ * 2. 按面板长边申请行传送中转缓冲
+ * 3. 注册为RT_Device_Class_Graphic设备
+ */
+rt_err_t LCDx_GraphicRegister(lcd_st7789_t *lcd, const char *name)
+{
+    struct lcd_graphic *gfx = RT_NULL;
+    rt_err_t res;
+    int i;
+
+    RT_ASSERT(lcd != RT_NULL);
+
+    if (lcd->spi == RT_NULL)
+        return -RT_ERROR;
+
+    for (i = 0; i < LCD_GFX_MAX; i++)
+    {
+        if (lcd_gfx[i].lcd == RT_NULL)
+        {
+            gfx = &lcd_gfx[i];
+            break;
+        }
+    }
+    if (gfx == RT_NULL)
+        return -RT_EFULL;
+
+    gfx->line_len = lcd->panel_w > lcd->panel_h ? lcd->panel_w : lcd->panel_h;
+    gfx->line = (u16 *)rt_malloc(gfx->line_len * sizeof(u16));
+    if (gfx->line == RT_NULL)
+        return -RT_ENOMEM;
+
+    gfx->ops = lcd_gfx_ops[i];
+    gfx->parent.type = RT_Device_Class_Graphic;
+#ifdef RT_USING_DEVICE_OPS
+    gfx->parent.ops = &lcd_gfx_dev_ops;
+#else
+    gfx->parent.init = RT_NULL;
+    gfx->parent.open = RT_NULL;
+    gfx->parent.close = RT_NULL;
+    gfx->parent.read = RT_NULL;
+    gfx->parent.write = RT_NULL;
+    gfx->parent.control = lcd_gfx_control;
+#endif
+    gfx->parent.user_data = gfx->ops;
+
+    res = rt_device_register(&gfx->parent, name, RT_DEVICE_FLAG_RDWR);
+    if (res != RT_EOK)
+    {
+        rt_free(gfx->line);
+        gfx->line = RT_NULL;
+        return res;
+    }
+    gfx->lcd = lcd;
+
+    LOG_I("graphic device %s registered", name);
+    return RT_EOK;
+}
+
+/**
+ * @brief 注册默认实例为"lcd"图形设备
+ * @return RT_EOK成功
+ *
+ * 功能说明：在spi_lcd_init(组件初始化)之后自动执行
+ */
+static int lcd_graphic_init(void)
+{
+    return LCDx_GraphicRegister(LCD_GetDefault(), "lcd");
+}
+INIT_ENV_EXPORT(lcd_graphic_init);
@@ -0,0 +1,254 @@
+/*
+ * =====================================================================================
+ * @file    LCD_ST7789_LVGL.c
+ * @brief   ST7789 LVGL显示驱动适配(v8/v9)
+ * @author  Passionate0424
+ * @date    2025-07-11
+ * @version 1.0.0
+ *
+ * 主要功能：
+ *   - 为LCD实例注册LVGL显示，双绘制缓冲区，局部刷新模式
+ *   - flush_cb只投递刷新请求，由刷新线程完成SPI(DMA)传输后调用flush_ready
+ *   - LVGL渲染下一块缓冲区与上一块的传输并行进行
+ *
+ * 说明：
+ *   1. RT-Thread SPI框架没有异步完成回调，rt_spi_send在DMA传输期间阻塞调用线程，
+ *      因此由独立的刷新线程承担传输，DMA完成返回即相当于传输完成回调
+ *   2. LVGL等待缓冲区时通过wait_cb阻塞在事件上，刷新线程优先级不受LVGL线程影响
+ *   3. 默认实例由弱函数lv_port_disp_init自动注册，可在应用中重写
+ * =====================================================================================
+ */
+
+#include "LCD_ST7789.h"
+#include <rtthread.h>
+#include <lvgl.h>
+
+#define DBG_TAG "lcd.lvgl"
+#include <rtdbg.h>
+
+#ifdef PKG_ST_7789_LVGL_BUF_LINES
+#define LCD_LV_BUF_LINES PKG_ST_7789_LVGL_BUF_LINES // 每块绘制缓冲区的行数
+#else
+#define LCD_LV_BUF_LINES 20
+#endif
+#define LCD_LV_THREAD_STACK 1024
+#define LCD_LV_THREAD_PRIO (RT_THREAD_PRIORITY_MAX / 2 - 2) // 略高于常见的LVGL线程
+
+#define LCD_LV_EVT_REQ 0x01  // 有待发送的区域
+#define LCD_LV_EVT_DONE 0x02 // 区域发送完成
+
+#if LVGL_VERSION_MAJOR >= 9
+typedef lv_display_t lcd_lv_disp_t;
+#else
+#if LV_COLOR_DEPTH != 16
+#error "ST7789 LVGL port requires LV_COLOR_DEPTH 16"
+#endif
+typedef lv_disp_drv_t lcd_lv_disp_t;
+#endif
+
+/**
+ * @brief LVGL显示适配上下文
+ */
+struct lcd_lvgl
+{
+    lcd_st7789_t *lcd;   // 对应的LCD实例
+    lcd_lv_disp_t *disp; // LVGL显示(v9)或显示驱动(v8)
+    struct rt_event evt; // 刷新请求/完成事件
+    lv_area_t area;      // 待发送区域
+    const u16 *px;       // 待发送像素(RGB565)
+    volatile u8 busy;    // 1:区域尚未发送完成
+    u8 last;             // 1:该区域是本帧最后一块
+#if LVGL_VERSION_MAJOR < 9
+    lv_disp_draw_buf_t draw_buf;
+    lv_disp_drv_t drv;
+#endif
+};
+
+/**
+ * @brief 刷新线程
+ * @param parameter LVGL适配上下文
+ *
+ * 功能说明：
+ * 1. 等待flush_cb投递的区域
+ * 2. 阻塞发送(SPI驱动内部使用DMA)，期间LVGL继续渲染另一块缓冲区
+ * 3. 发送完成后清除busy并通知LVGL缓冲区可重用(对LVGL线程为一步完成)，再唤醒可能在等待的LVGL线程
+ */
+static void lcd_lv_flush_entry(void *parameter)
+{
+    struct lcd_lvgl *lv = (struct lcd_lvgl *)parameter;
+    rt_uint32_t set;
+
+    while (1)
+    {
+        rt_event_recv(&lv->evt, LCD_LV_EVT_REQ, RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR,
+                      RT_WAITING_FOREVER, &set);
+
+#if LVGL_VERSION_MAJOR < 9 && LV_COLOR_16_SWAP
+        // 缓冲区已是发送字节序，直接发送
+        LCDx_DispFlushWire(lv->lcd, lv->area.x1, lv->area.y1, lv->area.x2, lv->area.y2, lv->px);
+#else
+        LCDx_DispFlush(lv->lcd, lv->area.x1, lv->area.y1, lv->area.x2, lv->area.y2, lv->px);
+#endif
+#ifdef PKG_ST7789_USING_OVERLAY
+        LCDx_OverlayDamage(lv->lcd, lv->area.x1, lv->area.y1, lv->area.x2, lv->area.y2);
+        if (lv->last)
+            LCDx_OverlayFrame(lv->lcd);
+#endif
+
+        // 锁调度器，LVGL线程不会在清除busy与flush_ready之间投递新区域而被误清
+        rt_enter_critical();
+        lv->busy = 0;
+#if LVGL_VERSION_MAJOR >= 9
+        lv_display_flush_ready(lv->disp);
+#else
+        lv_disp_flush_ready(lv->disp);
+#endif
+        rt_exit_critical();
+        rt_event_send(&lv->evt, LCD_LV_EVT_DONE);
+    }
+}
+
+/**
+ * @brief 投递刷新请求
+ * @param lv LVGL适配上下文
+ * @param area 区域
+ * @param px 像素数据
+ * @param last 是否为本帧最后一块
+ *
+ * 功能说明：只记录区域并唤醒刷新线程，立即返回
+ */
+static void lcd_lv_post(struct lcd_lvgl *lv, const lv_area_t *area, const void *px, u8 last)
+{
+    lv->area = *area;
+    lv->last = last;
+    lv->px = (const u16 *)px;
+    lv->busy = 1;
+    rt_event_send(&lv->evt, LCD_LV_EVT_REQ);
+}
+
+/**
+ * @brief 等待刷新完成
+ * @param lv LVGL适配上下文
+ *
+ * 功能说明：
+ * 1. LVGL需要正在发送的缓冲区时调用，阻塞而不是空转
+ * 2. 以busy标志为准，忽略之前未被消费的完成事件(v9只调用一次wait_cb)
+ * 3. busy与LVGL自身的刷新状态同时清除，返回时缓冲区一定已发送完成
+ */
+static void lcd_lv_wait(struct lcd_lvgl *lv)
+{
+    rt_uint32_t set;
+
+    while (lv->busy)
+    {
+        rt_event_recv(&lv->evt, LCD_LV_EVT_DONE, RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR,
+                      RT_WAITING_FOREVER, &set);
+    }
+}
+
+#if LVGL_VERSION_MAJOR >= 9
+static void lcd_lv_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+    lcd_lv_post((struct lcd_lvgl *)lv_display_get_user_data(disp), area, px_map, lv_display_flush_is_last(disp));
+}
+
+static void lcd_lv_wait_cb(lv_display_t *disp)
+{
+    lcd_lv_wait((struct lcd_lvgl *)lv_display_get_user_data(disp));
+}
+#else
+static void lcd_lv_flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    lcd_lv_post((struct lcd_lvgl *)drv->user_data, area, color_p, lv_disp_flush_is_last(drv));
+}
+
+static void lcd_lv_wait_cb(lv_disp_drv_t *drv)
+{
+    lcd_lv_wait((struct lcd_lvgl *)drv->user_data);
+}
+#endif
+
+/**
+ * @brief 为LCD实例注册LVGL显示
+ * @param lcd LCD实例(须已挂载，异步初始化时等待就绪)
+ * @return RT_EOK成功，-RT_ENOMEM内存不足，-RT_ERROR实例未挂载或线程创建失败
+ *
+ * 功能说明：
+ * 1. 按当前方向的宽度申请两块绘制缓冲区(各PKG_ST_7789_LVGL_BUF_LINES行)
+ * 2. 创建刷新线程，flush_cb投递区域后立即返回
+ * 3. 须在lv_init之后、LVGL线程中调用
+ */
+rt_err_t LCDx_LvglRegister(lcd_st7789_t *lcd)
+{
+    struct lcd_lvgl *lv;
+    rt_thread_t tid;
+    u32 buf_px;
+    void *buf1, *buf2;
+
+    RT_ASSERT(lcd != RT_NULL);
+
+    if (LCDx_WaitReady(lcd, RT_WAITING_FOREVER) != RT_EOK)
+        return -RT_ERROR;
+
+    buf_px = (u32)lcd->dev->width * LCD_LV_BUF_LINES;
+    lv = (struct lcd_lvgl *)rt_calloc(1, sizeof(struct lcd_lvgl));
+    buf1 = rt_malloc(buf_px * sizeof(u16));
+    buf2 = rt_malloc(buf_px * sizeof(u16));
+    if (lv == RT_NULL || buf1 == RT_NULL || buf2 == RT_NULL)
+    {
+        rt_free(buf2);
+        rt_free(buf1);
+        rt_free(lv);
+        return -RT_ENOMEM;
+    }
+
+    tid = rt_thread_create("lcd_lv", lcd_lv_flush_entry, lv, LCD_LV_THREAD_STACK, LCD_LV_THREAD_PRIO, 10);
+    if (tid == RT_NULL)
+    {
+        LOG_E("create flush thread failed!");
+        rt_free(buf2);
+        rt_free(buf1);
+        rt_free(lv);
+        return -RT_ERROR;
+    }
+
+    lv->lcd = lcd;
+    rt_event_init(&lv->evt, "lcd_lv", RT_IPC_FLAG_FIFO);
+
+#if LVGL_VERSION_MAJOR >= 9
+    lv->disp = lv_display_create(lcd->dev->width, lcd->dev->height);
+    lv_display_set_color_format(lv->disp, LV_COLOR_FORMAT_RGB565);
+    lv_display_set_buffers(lv->disp, buf1, buf2, buf_px * sizeof(u16), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_user_data(lv->disp, lv);
+    lv_display_set_flush_cb(lv->disp, lcd_lv_flush_cb);
+    lv_display_set_flush_wait_cb(lv->disp, lcd_lv_wait_cb);
+#else
+    lv_disp_draw_buf_init(&lv->draw_buf, buf1, buf2, buf_px);
+    lv_disp_drv_init(&lv->drv);
+    lv->drv.hor_res = lcd->dev->width;
+    lv->drv.ver_res = lcd->dev->height;
+    lv->drv.draw_buf = &lv->draw_buf;
+    lv->drv.flush_cb = lcd_lv_flush_cb;
+    lv->drv.wait_cb = lcd_lv_wait_cb;
+    lv->drv.user_data = lv;
+    lv->disp = &lv->drv;
+    lv_disp_drv_register(&lv->drv);
+#endif
+
+    rt_thread_startup(tid);
+
+    return RT_EOK;
+}
+
+/**
+ * @brief RT-Thread LVGL软件包的显示初始化入口
+ *
+ * 功能说明：注册默认实例，弱函数，需自定义时在应用中重写
+ */
+RT_WEAK void lv_port_disp_init(void)
+{
+    if (LCDx_LvglRegister(LCD_GetDefault()) != RT_EOK)
+    {
+        LOG_E("LVGL display register failed!");
+    }
+}
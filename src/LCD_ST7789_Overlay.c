@@ -0,0 +1,320 @@
+/*
+ * =====================================================================================
+ * @file    LCD_ST7789_Overlay.c
+ * @brief   ST7789 帧率/总线占用率叠加层
+ * @author  Passionate0424
+ * @date    2025-07-11
+ * @version 1.0.0
+ *
+ * 主要功能：
+ *   - 统计两次帧结束标记之间的帧率，以及SPI总线占用率
+ *   - 在屏幕一角以6x12字符显示，例如" 59.9fps  42%"
+ *   - MSH命令 lcd_overlay [on [corner]|off] 控制默认实例
+ *
+ * 说明：
+ *   1. 字形在开启时按前景/背景色预先展开为RGB565小图，之后每个字符一次窗口、一次发送
+ *   2. 每个统计周期只重绘与上次显示不同的字符，被应用覆盖的区域通过LCDx_OverlayDamage重绘
+ *   3. 总线占用率 = 周期内发送的位数 / (SPI时钟 × 周期时长)，不受tick精度限制
+ *   4. 驱动不带实例锁，绘制只在调用LCDx_OverlayFrame的绘图线程中进行
+ * =====================================================================================
+ */
+
+#include "LCD_ST7789.h"
+#include <rtthread.h>
+#include "font.h"
+
+#ifdef PKG_ST_7789_OVERLAY_PERIOD
+#define LCD_OVL_PERIOD PKG_ST_7789_OVERLAY_PERIOD // 统计与刷新周期(ms)
+#else
+#define LCD_OVL_PERIOD 500
+#endif
+
+#define LCD_OVL_CW 6   // 字符宽度
+#define LCD_OVL_CH 12  // 字符高度
+#define LCD_OVL_LEN 13 // 显示字符数
+
+static const char lcd_ovl_charset[] = " 0123456789.%fps"; // 缓存的字形，首个为空格
+#define LCD_OVL_GLYPHS (sizeof(lcd_ovl_charset) - 1)
+
+/**
+ * @brief 叠加层状态
+ */
+struct lcd_overlay
+{
+    u16 glyph[LCD_OVL_GLYPHS][LCD_OVL_CW * LCD_OVL_CH]; // 展开后的字形(行优先，主机字节序)
+    char shown[LCD_OVL_LEN + 1];                       // 屏幕上当前的字符
+    char text[LCD_OVL_LEN + 1];                        // 最近一次统计的字符
+    u16 x, y;                                          // 上次绘制的左上角
+    u8 corner;                                         // 位置(LCD_OVL_xxx)
+    volatile u8 dirty;                                 // 1:全部字符需要重绘
+    volatile u8 stopping;                              // 1:下一次帧标记时释放
+    rt_tick_t t0;                                      // 本周期开始时刻
+    u32 frames;                                        // 本周期帧数
+};
+
+/**
+ * @brief 展开字形
+ * @param ovl 叠加层
+ * @param color 前景色
+ * @param bg_color 背景色
+ *
+ * 功能说明：asc2_1206每列2字节(高位在上，只用12位)，转换为行优先的RGB565小图
+ */
+static void lcd_ovl_render(struct lcd_overlay *ovl, u16 color, u16 bg_color)
+{
+    u8 g, col, row;
+    const u8 *font;
+
+    for (g = 0; g < LCD_OVL_GLYPHS; g++)
+    {
+        font = asc2_1206[lcd_ovl_charset[g] - ' '];
+        for (col = 0; col < LCD_OVL_CW; col++)
+        {
+            for (row = 0; row < LCD_OVL_CH; row++)
+            {
+                ovl->glyph[g][row * LCD_OVL_CW + col] =
+                    (font[col * 2 + row / 8] & (0x80 >> (row % 8))) ? color : bg_color;
+            }
+        }
+    }
+}
+
+/**
+ * @brief 查找字符对应的字形
+ * @param c 字符
+ * @return 字形序号，字符集以外的字符按空格处理
+ */
+static u8 lcd_ovl_index(char c)
+{
+    u8 g;
+
+    for (g = 1; g < LCD_OVL_GLYPHS; g++)
+    {
+        if (lcd_ovl_charset[g] == c)
+            return g;
+    }
+    return 0;
+}
+
+/**
+ * @brief 重绘有变化的字符
+ * @param lcd LCD实例
+ * @param ovl 叠加层
+ *
+ * 功能说明：
+ * 1. 按当前方向的宽高计算位置，位置改变(如横竖屏切换)时全部重绘
+ * 2. 其余情况只发送与屏幕上不同的字符
+ * 3. 绘制期间暂停统计，叠加层自身的传输不计入LCD_ShowImage统计与总线占用率
+ */
+static void lcd_ovl_draw(lcd_st7789_t *lcd, struct lcd_overlay *ovl)
+{
+    u16 w = LCD_OVL_CW * LCD_OVL_LEN;
+    u16 x, y;
+    u8 i, all;
+
+    if (lcd->dev->width < w || lcd->dev->height < LCD_OVL_CH)
+        return;
+
+    x = (ovl->corner & 1) ? lcd->dev->width - w : 0;
+    y = (ovl->corner & 2) ? lcd->dev->height - LCD_OVL_CH : 0;
+    all = ovl->dirty || x != ovl->x || y != ovl->y;
+    ovl->dirty = 0;
+    ovl->x = x;
+    ovl->y = y;
+
+    lcd->prof_mute = 1;
+    for (i = 0; i < LCD_OVL_LEN; i++)
+    {
+        if (!all && ovl->text[i] == ovl->shown[i])
+            continue;
+
+        LCDx_ShowImage(lcd, x + i * LCD_OVL_CW, y, LCD_OVL_CW, LCD_OVL_CH, ovl->glyph[lcd_ovl_index(ovl->text[i])]);
+        ovl->shown[i] = ovl->text[i];
+    }
+    lcd->prof_mute = 0;
+}
+
+/**
+ * @brief 开启性能叠加层
+ * @param lcd LCD实例(须已挂载)
+ * @param corner 位置(LCD_OVL_TOP_LEFT/TOP_RIGHT/BOTTOM_LEFT/BOTTOM_RIGHT)
+ * @param color 文字颜色
+ * @param bg_color 背景颜色
+ * @return RT_EOK成功，-RT_EBUSY已开启，-RT_ENOMEM内存不足
+ *
+ * 功能说明：
+ * 1. 申请约2.4KB状态并展开字形
+ * 2. 之后每次LCDx_OverlayFrame计一帧，满一个周期更新显示
+ * 3. 已关闭但尚未被LCDx_OverlayFrame释放时直接复用，按新参数重新开始
+ */
+rt_err_t LCDx_OverlayStart(lcd_st7789_t *lcd, u8 corner, u16 color, u16 bg_color)
+{
+    struct lcd_overlay *ovl;
+
+    RT_ASSERT(lcd != RT_NULL);
+
+    // 取消尚未生效的关闭，与LCDx_OverlayFrame中的释放互斥
+    rt_enter_critical();
+    ovl = lcd->overlay;
+    if (ovl != RT_NULL)
+    {
+        if (!ovl->stopping)
+        {
+            rt_exit_critical();
+            return -RT_EBUSY;
+        }
+        ovl->stopping = 0;
+    }
+    rt_exit_critical();
+
+    if (ovl == RT_NULL)
+    {
+        ovl = (struct lcd_overlay *)rt_calloc(1, sizeof(struct lcd_overlay));
+        if (ovl == RT_NULL)
+            return -RT_ENOMEM;
+    }
+
+    lcd_ovl_render(ovl, color, bg_color);
+    rt_strncpy(ovl->text, "  0.0fps   0%", sizeof(ovl->text));
+    ovl->corner = corner & 3;
+    ovl->frames = 0;
+    ovl->t0 = rt_tick_get();
+    ovl->dirty = 1;
+    lcd->ovl_bytes = 0;
+    lcd->overlay = ovl;
+
+    return RT_EOK;
+}
+
+/**
+ * @brief 关闭性能叠加层
+ * @param lcd LCD实例
+ *
+ * 功能说明：
+ * 1. 只做标记，由绘图线程在下一次LCDx_OverlayFrame时释放，避免与正在进行的绘制冲突
+ * 2. 不擦除屏幕上的内容，由应用在下一帧覆盖
+ */
+void LCDx_OverlayStop(lcd_st7789_t *lcd)
+{
+    RT_ASSERT(lcd != RT_NULL);
+
+    if (lcd->overlay != RT_NULL)
+        lcd->overlay->stopping = 1;
+}
+
+/**
+ * @brief 标记一帧结束
+ * @param lcd LCD实例
+ *
+ * 功能说明：
+ * 1. 应用在每帧画完(或GUI提交一帧)后调用；LVGL适配与图形设备RECT_UPDATE会自动调用
+ * 2. 满PKG_ST_7789_OVERLAY_PERIOD毫秒时计算帧率(0.1fps)与总线占用率并重绘变化的字符
+ * 3. 期间被LCDx_OverlayDamage标记的叠加层立即整块重绘
+ */
+void LCDx_OverlayFrame(lcd_st7789_t *lcd)
+{
+    struct lcd_overlay *ovl;
+    rt_tick_t elapsed;
+    rt_uint32_t ms, fps, busy;
+
+    RT_ASSERT(lcd != RT_NULL);
+
+    ovl = lcd->overlay;
+    if (ovl == RT_NULL)
+        return;
+    rt_enter_critical();
+    if (ovl->stopping)
+    {
+        lcd->overlay = RT_NULL;
+        rt_exit_critical();
+        rt_free(ovl);
+        return;
+    }
+    rt_exit_critical();
+
+    ovl->frames++;
+    elapsed = rt_tick_get() - ovl->t0;
+    if (elapsed < rt_tick_from_millisecond(LCD_OVL_PERIOD))
+    {
+        if (ovl->dirty)
+            lcd_ovl_draw(lcd, ovl);
+        return;
+    }
+
+    ms = (rt_uint32_t)((rt_uint64_t)elapsed * 1000 / RT_TICK_PER_SECOND);
+    fps = ovl->frames * 10000 / ms;
+    busy = (rt_uint32_t)((rt_uint64_t)lcd->ovl_bytes * 8 * 100 * 1000 / ((rt_uint64_t)lcd->spi_hz * ms));
+    if (fps > 9999)
+        fps = 9999;
+    if (busy > 100)
+        busy = 100;
+
+    ovl->frames = 0;
+    ovl->t0 += elapsed;
+    lcd->ovl_bytes = 0;
+
+    rt_snprintf(ovl->text, sizeof(ovl->text), "%3u.%ufps %3u%%", fps / 10, fps % 10, busy);
+    lcd_ovl_draw(lcd, ovl);
+}
+
+/**
+ * @brief 通知叠加层区域被覆盖
+ * @param lcd LCD实例
+ * @param x1 起始X坐标
+ * @param y1 起始Y坐标
+ * @param x2 结束X坐标
+ * @param y2 结束Y坐标
+ *
+ * 功能说明：与叠加层相交时在下一次帧标记时整块重绘，应用在叠加层所在角绘图后调用
+ */
+void LCDx_OverlayDamage(lcd_st7789_t *lcd, u16 x1, u16 y1, u16 x2, u16 y2)
+{
+    struct lcd_overlay *ovl;
+
+    RT_ASSERT(lcd != RT_NULL);
+
+    ovl = lcd->overlay;
+    if (ovl == RT_NULL)
+        return;
+    if (x2 >= ovl->x && x1 < ovl->x + LCD_OVL_CW * LCD_OVL_LEN && y2 >= ovl->y && y1 < ovl->y + LCD_OVL_CH)
+        ovl->dirty = 1;
+}
+
+#ifdef RT_USING_FINSH
+/**
+ * @brief 开启/关闭默认实例的性能叠加层
+ * @param argc 参数个数
+ * @param argv 参数列表
+ * @return 0成功，-1失败
+ *
+ * 功能说明：
+ * 1. lcd_overlay on [corner]：corner为0~3(左上/右上/左下/右下)，默认右上，白字黑底
+ * 2. lcd_overlay off：关闭
+ */
+static int lcd_overlay(int argc, char **argv)
+{
+    lcd_st7789_t *lcd = LCD_GetDefault();
+    u8 corner = LCD_OVL_TOP_RIGHT;
+
+    if (argc >= 2 && rt_strcmp(argv[1], "off") == 0)
+    {
+        LCDx_OverlayStop(lcd);
+        return 0;
+    }
+    if (argc >= 2 && rt_strcmp(argv[1], "on") == 0)
+    {
+        if (argc >= 3)
+            corner = (u8)(argv[2][0] - '0');
+        if (corner > LCD_OVL_BOTTOM_RIGHT || LCDx_OverlayStart(lcd, corner, WHITE, BLACK) != RT_EOK)
+        {
+            rt_kprintf("lcd_overlay: start failed\n");
+            return -1;
+        }
+        return 0;
+    }
+
+    rt_kprintf("Usage: lcd_overlay on [0-3] | off\n");
+    return -1;
+}
+MSH_CMD_EXPORT(lcd_overlay, "Show or hide the LCD fps/bus-load overlay");
+#endif
@@ -0,0 +1,127 @@
+/*
+ * =====================================================================================
+ * @file    LCD_ST7789_Stats.c
+ * @brief   ST7789 接口性能统计
+ * @author  Passionate0424
+ * @date    2025-07-11
+ * @version 1.0.0
+ *
+ * 主要功能：
+ *   - 按公开接口统计调用次数、SPI字节数/传输次数、窗口设置次数与累计耗时
+ *   - 统计快照、清零与打印
+ *   - MSH命令 lcd_stats [reset] 查看默认实例的统计
+ *
+ * 说明：
+ *   1. 计数在LCD_ST7789.c的接口入口/出口与SPI发送处累加，本文件只负责读取与显示
+ *   2. 耗时默认以系统tick计，开启PKG_ST7789_PROFILE_USING_DWT后以DWT周期计数器计，
+ *      短小接口(画点、单字符)在tick精度下通常为0，需要时请开启DWT
+ *   3. 统计不加锁，多个线程同时操作同一实例时数值为近似值
+ * =====================================================================================
+ */
+
+#include "LCD_ST7789.h"
+#include <rtthread.h>
+
+/**
+ * @brief 复制统计快照
+ * @param lcd LCD实例
+ * @param out 输出数组，至少LCD_STAT_MAX项
+ *
+ * 功能说明：复制期间关闭调度，避免快照中途被绘图线程修改
+ */
+void LCDx_StatsGet(lcd_st7789_t *lcd, lcd_stat_t *out)
+{
+    RT_ASSERT(lcd != RT_NULL && out != RT_NULL);
+
+    rt_enter_critical();
+    rt_memcpy(out, lcd->stats, sizeof(lcd->stats));
+    rt_exit_critical();
+}
+
+/**
+ * @brief 清零统计
+ * @param lcd LCD实例
+ *
+ * 功能说明：只清零计数，正在执行的接口结束后仍正常计入
+ */
+void LCDx_StatsReset(lcd_st7789_t *lcd)
+{
+    RT_ASSERT(lcd != RT_NULL);
+
+    rt_enter_critical();
+    rt_memset(lcd->stats, 0, sizeof(lcd->stats));
+    rt_exit_critical();
+}
+
+/**
+ * @brief 打印统计表
+ * @param lcd LCD实例
+ *
+ * 功能说明：
+ * 1. 每个被调用过的接口一行：调用次数、发送字节、传输次数、窗口次数、累计与平均耗时
+ * 2. 最后一行为合计，字节数同时给出按耗时折算的吞吐率
+ */
+void LCDx_StatsDump(lcd_st7789_t *lcd)
+{
+    lcd_stat_t snap[LCD_STAT_MAX];
+    u32 calls = 0, bytes = 0, xfers = 0, windows = 0;
+    rt_uint64_t time = 0;
+    rt_uint32_t us;
+    u8 i;
+
+    LCDx_StatsGet(lcd, snap);
+
+    rt_kprintf("%-14s %8s %10s %8s %8s %10s %8s\n", "api", "calls", "bytes", "xfers", "windows", "time(us)", "avg(us)");
+    for (i = 0; i < LCD_STAT_MAX; i++)
+    {
+        if (snap[i].calls == 0 && snap[i].bytes == 0)
+            continue;
+
+        us = LCD_ProfToUs(snap[i].time);
+        rt_kprintf("%-14s %8u %10u %8u %8u %10u %8u\n", LCD_StatName(i), snap[i].calls, snap[i].bytes,
+                   snap[i].xfers, snap[i].windows, us, snap[i].calls ? us / snap[i].calls : 0);
+
+        calls += snap[i].calls;
+        bytes += snap[i].bytes;
+        xfers += snap[i].xfers;
+        windows += snap[i].windows;
+        time += snap[i].time;
+    }
+
+    us = LCD_ProfToUs(time);
+    rt_kprintf("%-14s %8u %10u %8u %8u %10u\n", "total", calls, bytes, xfers, windows, us);
+    if (us >= 1000)
+        rt_kprintf("throughput     %u KB/s\n", (u32)((rt_uint64_t)bytes * 1000 / us * 1000 / 1024));
+}
+
+#ifdef RT_USING_FINSH
+/**
+ * @brief 查看或清零默认实例的性能统计
+ * @param argc 参数个数
+ * @param argv 参数列表
+ * @return 0成功，-1参数错误
+ *
+ * 功能说明：
+ * 1. 不带参数打印统计表
+ * 2. lcd_stats reset 清零统计
+ */
+static int lcd_stats(int argc, char **argv)
+{
+    lcd_st7789_t *lcd = LCD_GetDefault();
+
+    if (argc == 2 && rt_strcmp(argv[1], "reset") == 0)
+    {
+        LCDx_StatsReset(lcd);
+        return 0;
+    }
+    if (argc != 1)
+    {
+        rt_kprintf("Usage: lcd_stats [reset]\n");
+        return -1;
+    }
+
+    LCDx_StatsDump(lcd);
+    return 0;
+}
+MSH_CMD_EXPORT(lcd_stats, "Show or reset LCD per-API performance counters");
+#endif
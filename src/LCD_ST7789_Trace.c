@@ -0,0 +1,131 @@
+/*
+ * =====================================================================================
+ * @file    LCD_ST7789_Trace.c
+ * @brief   ST7789 驱动操作跟踪导出
+ * @author  Passionate0424
+ * @date    2025-07-11
+ * @version 1.0.0
+ *
+ * 主要功能：
+ *   - 按文本行打印环形缓冲区中的跟踪记录
+ *   - MSH命令 lcd_trace [clear|on|off]
+ *
+ * 说明：
+ *   1. 记录在LCD_ST7789.c的接口出口与SPI传输处写入，本文件只负责导出
+ *   2. 打印的文本由tools/lcd_trace2json.py转换为Chrome trace/Perfetto可打开的JSON，
+ *      每个线程一条时间线，接口记录下嵌套其SPI传输
+ *   3. 时刻默认以系统tick计，开启PKG_ST7789_PROFILE_USING_DWT后精确到CPU周期
+ * =====================================================================================
+ */
+
+#include "LCD_ST7789.h"
+#include <rtthread.h>
+
+#define LCD_TRACE_CHUNK 8 // 每次读取的记录数，控制打印时的栈占用
+
+static const char *const lcd_trace_xfer_names[] = {"spi_cmd", "spi_data", "spi_read"};
+
+/**
+ * @brief 获取记录的操作名称
+ * @param op 操作(LCD_STAT_xxx或LCD_TRACE_xxx)
+ * @return 名称
+ */
+static const char *lcd_trace_op_name(u8 op)
+{
+    if (op >= LCD_TRACE_CMD && op <= LCD_TRACE_READ)
+        return lcd_trace_xfer_names[op - LCD_TRACE_CMD];
+    return LCD_StatName(op);
+}
+
+/**
+ * @brief 带符号的计时差值换算为微秒
+ * @param diff 计时差值
+ * @return 微秒数
+ */
+static rt_int32_t lcd_trace_diff_us(rt_int32_t diff)
+{
+    return diff >= 0 ? (rt_int32_t)LCD_ProfToUs(diff) : -(rt_int32_t)LCD_ProfToUs(-(rt_int64_t)diff);
+}
+
+/**
+ * @brief 打印全部跟踪记录
+ *
+ * 功能说明：
+ * 1. 打印期间暂停记录，结束后恢复原状态
+ * 2. 每条记录一行：T 开始(us) 时长(us) 设备 线程 操作 x y w h 字节数
+ * 3. 时刻以相邻记录的结束时刻之差逐条累加换算，计时器回绕不影响结果；
+ *    以第一条记录的开始时刻为0，比它先开始的外层接口为负值
+ */
+void LCD_TraceDump(void)
+{
+    lcd_trace_rec_t rec[LCD_TRACE_CHUNK];
+    rt_uint32_t start = 0, n, i, end, prev_end = 0;
+    rt_int32_t end_us = 0, dur_us;
+    char thread[RT_NAME_MAX + 1];
+    u8 was_on = LCD_TraceEnable(0);
+
+    rt_kprintf("# lcd_trace v1, time in us, %u dropped\n", LCD_TraceDropped());
+    rt_kprintf("# T ts dur dev thread op x y w h bytes\n");
+    while ((n = LCD_TraceRead(start, rec, LCD_TRACE_CHUNK)) != 0)
+    {
+        for (i = 0; i < n; i++)
+        {
+            end = rec[i].ts + rec[i].dur;
+            dur_us = (rt_int32_t)LCD_ProfToUs(rec[i].dur);
+            if (start + i == 0)
+                end_us = dur_us;
+            else
+                end_us += lcd_trace_diff_us((rt_int32_t)(end - prev_end));
+            prev_end = end;
+
+            rt_memcpy(thread, rec[i].thread, RT_NAME_MAX);
+            thread[RT_NAME_MAX] = '\0';
+            rt_kprintf("T %d %d %s %s %s %u %u %u %u %u\n", end_us - dur_us, dur_us,
+                       rec[i].dev ? rec[i].dev : "-", thread[0] ? thread : "-",
+                       lcd_trace_op_name(rec[i].op), rec[i].x, rec[i].y, rec[i].w, rec[i].h, rec[i].bytes);
+        }
+        start += n;
+    }
+
+    LCD_TraceEnable(was_on);
+}
+
+#ifdef RT_USING_FINSH
+/**
+ * @brief 导出或控制驱动操作跟踪
+ * @param argc 参数个数
+ * @param argv 参数列表
+ * @return 0成功，-1参数错误
+ *
+ * 功能说明：
+ * 1. 不带参数打印全部记录，复制串口输出后在主机上转换为JSON
+ * 2. clear清空记录，on/off开始/暂停记录
+ */
+static int lcd_trace(int argc, char **argv)
+{
+    if (argc == 1)
+    {
+        LCD_TraceDump();
+        return 0;
+    }
+    if (argc == 2 && rt_strcmp(argv[1], "clear") == 0)
+    {
+        LCD_TraceClear();
+        return 0;
+    }
+    if (argc == 2 && rt_strcmp(argv[1], "on") == 0)
+    {
+        LCD_TraceEnable(1);
+        return 0;
+    }
+    if (argc == 2 && rt_strcmp(argv[1], "off") == 0)
+    {
+        LCD_TraceEnable(0);
+        return 0;
+    }
+
+    rt_kprintf("Usage: lcd_trace [clear|on|off]\n");
+    return -1;
+}
+MSH_CMD_EXPORT(lcd_trace, "Dump or control the LCD driver operation trace");
+#endif
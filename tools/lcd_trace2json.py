@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+把 MSH 命令 lcd_trace 打印的跟踪记录转换为 Chrome trace / Perfetto 可打开的 JSON。
+
+用法：
+    python3 lcd_trace2json.py serial.log [-o trace.json]
+
+输入为包含 lcd_trace 输出的串口日志，其它行会被忽略；每行记录格式为
+    T 开始(us) 时长(us) 设备 线程 操作 x y w h 字节数
+输出中每个 LCD 实例(SPI设备)为一个进程、每个调用线程为一条时间线，
+SPI 传输嵌套显示在所属接口之下。在 chrome://tracing 或 https://ui.perfetto.dev 中打开。
+"""
+
+import argparse
+import json
+import re
+import sys
+
+RECORD = re.compile(r"\bT (-?\d+) (-?\d+) (\S+) (\S+) (\S+) (\d+) (\d+) (\d+) (\d+) (\d+)\s*$")
+XFER_OPS = ("spi_cmd", "spi_data", "spi_read")
+
+
+def parse(lines):
+    records = []
+    for line in lines:
+        m = RECORD.search(line)
+        if m is None:
+            continue
+        ts, dur, dev, thread, op, x, y, w, h, nbytes = m.groups()
+        records.append({
+            "ts": int(ts), "dur": int(dur), "dev": dev, "thread": thread, "op": op,
+            "x": int(x), "y": int(y), "w": int(w), "h": int(h), "bytes": int(nbytes),
+        })
+    return records
+
+
+def convert(records):
+    events = []
+    pids = {}
+    tids = {}
+    base = min((r["ts"] for r in records), default=0)
+
+    for r in records:
+        if r["dev"] not in pids:
+            pids[r["dev"]] = len(pids) + 1
+            events.append({"name": "process_name", "ph": "M", "pid": pids[r["dev"]],
+                           "args": {"name": "lcd " + r["dev"]}})
+        pid = pids[r["dev"]]
+        key = (pid, r["thread"])
+        if key not in tids:
+            tids[key] = len(tids) + 1
+            events.append({"name": "thread_name", "ph": "M", "pid": pid, "tid": tids[key],
+                           "args": {"name": r["thread"]}})
+
+        events.append({
+            "name": r["op"],
+            "cat": "spi" if r["op"] in XFER_OPS else "api",
+            "ph": "X",
+            "ts": r["ts"] - base,
+            # tick 计时下短操作时长为 0，给 1us 以便在时间线上可见
+            "dur": max(r["dur"], 1),
+            "pid": pid,
+            "tid": tids[key],
+            "args": {"window": "%d,%d %dx%d" % (r["x"], r["y"], r["w"], r["h"]), "bytes": r["bytes"]},
+        })
+
+    # 同一起点时先放外层接口，查看器才能正确嵌套
+    events.sort(key=lambda e: (e["ph"] != "M", e.get("ts", 0), -e.get("dur", 0)))
+    return {"traceEvents": events, "displayTimeUnit": "ms"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert lcd_trace output to Chrome trace JSON")
+    parser.add_argument("input", nargs="?", help="serial log containing lcd_trace output (default: stdin)")
+    parser.add_argument("-o", "--output", help="output JSON file (default: stdout)")
+    args = parser.parse_args()
+
+    if args.input:
+        with open(args.input, encoding="utf-8", errors="replace") as f:
+            records = parse(f)
+    else:
+        records = parse(sys.stdin)
+    if not records:
+        sys.exit("no lcd_trace records found")
+
+    trace = convert(records)
+    if args.output:
+        with open(args.output, "w", encoding="utf-8") as f:
+            json.dump(trace, f)
+    else:
+        json.dump(trace, sys.stdout)
+        sys.stdout.write("\n")
+
+
+if __name__ == "__main__":
+    main()